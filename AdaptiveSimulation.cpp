@@ -0,0 +1,185 @@
+#include "AdaptiveSimulation.h"
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "SchemeFactory.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+AdaptiveSimulation::AdaptiveSimulation(const HeatProblem& problem,
+    const std::string& scheme_name,
+    double dt_initial, double t_end,
+    const AdaptiveOptions& options)
+    : problem_(problem),
+    dt_initial_(dt_initial),
+    t_end_(t_end),
+    options_(options)
+{
+    if (scheme_name == "Laasonen") {
+        order_ = 1;
+    }
+    else if (scheme_name == "CrankNicolson") {
+        order_ = 2;
+    }
+    else {
+        throw std::runtime_error("AdaptiveSimulation: adaptive stepping needs an implicit scheme (Laasonen or CrankNicolson), got '"
+            + scheme_name + "'");
+    }
+    if (dt_initial <= 0.0 || t_end <= 0.0) {
+        throw std::runtime_error("AdaptiveSimulation: dt and t_end must be positive");
+    }
+
+    if (options_.dt_min <= 0.0) {
+        options_.dt_min = 1e-9 * t_end;
+    }
+    if (options_.dt_max <= 0.0) {
+        options_.dt_max = t_end;
+    }
+
+    const std::size_t N = problem.grid().size();
+    full_ = make_scheme(scheme_name, problem);
+    half_scheme_ = make_scheme(scheme_name, problem);
+    full_->prepare(N);
+    half_scheme_->prepare(N);
+
+    T_.resize(N);
+    full_step_.resize(N);
+    midpoint_.resize(N);
+    half_.resize(N);
+}
+
+void AdaptiveSimulation::set_output_times(std::vector<double> times,
+    OutputCallback callback)
+{
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    for (double t : times) {
+        if (t <= 0.0 || t > t_end_) {
+            throw std::runtime_error("AdaptiveSimulation::set_output_times: times must lie in (0, t_end]");
+        }
+    }
+    output_times_ = std::move(times);
+    on_output_ = std::move(callback);
+}
+
+double AdaptiveSimulation::try_step(double t, double dt)
+{
+    // Single-level schemes: T_prev is not used
+    full_->step(T_, T_, full_step_, t, dt);
+    half_scheme_->step(T_, T_, midpoint_, t, 0.5 * dt);
+    half_scheme_->step(midpoint_, midpoint_, half_, t + 0.5 * dt, 0.5 * dt);
+
+    // Error of the half-step result: (half - full) / (2^p - 1)
+    const double scale = 1.0 / (std::pow(2.0, order_) - 1.0);
+    double norm = 0.0;
+    for (std::size_t i = 0; i < T_.size(); ++i) {
+        double err = std::abs(half_[i] - full_step_[i]) * scale;
+        double tol = options_.atol + options_.rtol * std::abs(half_[i]);
+        norm = std::max(norm, err / tol);
+    }
+    return norm;
+}
+
+double AdaptiveSimulation::run_to_end()
+{
+    HEAT_SCOPED_TIMER(Simulation, 1, 0, 0);
+
+    problem_.set_initial_condition(T_);
+    stats_ = AdaptiveStats();
+    stats_.fixed_steps = static_cast<std::size_t>(std::round(t_end_ / dt_initial_));
+
+    // Targets the march must hit exactly
+    std::vector<double> targets = output_times_;
+    if (targets.empty() || targets.back() != t_end_) {
+        targets.push_back(t_end_);
+    }
+
+    // PI controller (Gustafsson): exponents for an error of order p + 1
+    const double k_i = 0.7 / (order_ + 1);
+    const double k_p = 0.4 / (order_ + 1);
+
+    double t = 0.0;
+    double dt = std::min(std::max(dt_initial_, options_.dt_min), options_.dt_max);
+    double previous_norm = 1.0;
+    std::size_t next_target = 0;
+
+    while (next_target < targets.size()) {
+        const double target = targets[next_target];
+
+        // Shorten the step to land on the target; stretch it slightly
+        // rather than leave a sliver
+        double step = dt;
+        bool lands = false;
+        if (t + 1.01 * step >= target) {
+            step = target - t;
+            lands = true;
+        }
+
+        double norm = try_step(t, step);
+
+        if (norm > 1.0 && step > options_.dt_min) {
+            ++stats_.rejected;
+            double factor = options_.safety * std::pow(1.0 / norm, 1.0 / (order_ + 1));
+            dt = std::max(options_.dt_min,
+                step * std::max(options_.max_shrink, std::min(1.0, factor)));
+            continue;
+        }
+        if (norm > 1.0) {
+            ++stats_.forced;
+        }
+
+        // Accept the half-step result
+        T_.swap(half_);
+        ++stats_.accepted;
+        stats_.smallest_dt = (stats_.accepted == 1) ? step : std::min(stats_.smallest_dt, step);
+        stats_.largest_dt = std::max(stats_.largest_dt, step);
+
+        if (lands) {
+            t = target;
+            if (on_output_ && next_target < output_times_.size()) {
+                on_output_(t, T_);
+            }
+            ++next_target;
+        }
+        else {
+            t += step;
+        }
+
+        // Next step size; a shortened landing step does not shrink dt
+        norm = std::max(norm, 1e-10);
+        double factor = options_.safety * std::pow(1.0 / norm, k_i)
+            * std::pow(previous_norm, k_p);
+        factor = std::min(options_.max_growth, std::max(options_.max_shrink, factor));
+        previous_norm = norm;
+
+        if (factor < 1.0 || factor >= options_.hold_band) {
+            double base = lands ? std::max(dt, step) : step;
+            dt = std::min(options_.dt_max, std::max(options_.dt_min, base * factor));
+        }
+    }
+
+    return t;
+}
+
+void AdaptiveSimulation::run(const std::string& scheme_name, OutputManager& out)
+{
+    const Grid1D& grid = problem_.grid();
+
+    double t = run_to_end();
+
+    std::vector<double> T_exact;
+    if (AnalyticalSolution::applies(problem_)) {
+        AnalyticalSolution(problem_).evaluate(grid, t, T_exact);
+    }
+
+    out.store_scheme_result(scheme_name, grid, T_, T_exact);
+}
+
+const std::vector<double>& AdaptiveSimulation::solution() const {
+    return T_;
+}
+
+const AdaptiveStats& AdaptiveSimulation::stats() const {
+    return stats_;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "HeatProblem.h"
+#include "TimeScheme.h"
+#include "OutputManager.h"
+
+struct AdaptiveOptions {
+    // A step is accepted when |error_i| <= atol + rtol * |T_i| at every node
+    double atol = 1e-3;            // K
+    double rtol = 1e-4;
+    double dt_min = 0.0;           // 0: 1e-9 * t_end
+    double dt_max = 0.0;           // 0: t_end
+    double safety = 0.9;
+    double max_growth = 5.0;       // per accepted step
+    double max_shrink = 0.2;
+    double hold_band = 1.2;        // growth below this keeps dt (and the factors)
+};
+
+struct AdaptiveStats {
+    std::size_t accepted = 0;
+    std::size_t rejected = 0;
+    std::size_t forced = 0;        // accepted at dt_min despite the error
+    std::size_t fixed_steps = 0;   // steps of a fixed-dt run with the initial dt
+    double smallest_dt = 0.0;
+    double largest_dt = 0.0;
+
+    // Implicit solves: every attempt, accepted or rejected, takes one step
+    // with dt and two with dt/2
+    std::size_t solves() const { return 3 * (accepted + rejected); }
+
+    // Solves saved against the fixed-dt run (one per step); negative when
+    // the adaptive run costs more. Say nothing about accuracy: compare the
+    // errors as well (heat --adaptive).
+    long long solves_saved() const {
+        return static_cast<long long>(fixed_steps) - static_cast<long long>(solves());
+    }
+};
+
+// Time stepping with error control for the implicit schemes (Laasonen,
+// CrankNicolson).
+//
+// Each step is taken once with dt and twice with dt/2; the difference
+// estimates the local error of the half-step result, which is kept. A PI
+// controller picks the next dt from the current and previous error. The
+// full- and half-step schemes are separate instances, so each keeps its
+// factorization while dt is held. Steps are shortened to land exactly on
+// every output time and on t_end.
+class AdaptiveSimulation {
+public:
+    using OutputCallback = std::function<void(double t, const std::vector<double>& T)>;
+
+    AdaptiveSimulation(const HeatProblem& problem,
+        const std::string& scheme_name,
+        double dt_initial, double t_end,
+        const AdaptiveOptions& options = AdaptiveOptions());
+
+    // Profiles at these times (within (0, t_end]) are passed to callback
+    void set_output_times(std::vector<double> times, OutputCallback callback);
+
+    // Marches to t_end; returns the time reached (exactly t_end)
+    double run_to_end();
+
+    // run_to_end() and store the result with its analytical reference
+    void run(const std::string& scheme_name, OutputManager& out);
+
+    const std::vector<double>& solution() const;
+    const AdaptiveStats& stats() const;
+
+private:
+    // Returns the scaled error norm of a step from T_ of length dt;
+    // the half-step result is left in half_
+    double try_step(double t, double dt);
+
+    const HeatProblem& problem_;
+    std::unique_ptr<TimeScheme> full_;
+    std::unique_ptr<TimeScheme> half_scheme_;
+    int order_;
+    double dt_initial_;
+    double t_end_;
+    AdaptiveOptions options_;
+
+    std::vector<double> output_times_;
+    OutputCallback on_output_;
+
+    std::vector<double> T_;
+    std::vector<double> full_step_;
+    std::vector<double> midpoint_;
+    std::vector<double> half_;
+
+    AdaptiveStats stats_;
+};
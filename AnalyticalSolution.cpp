@@ -1,37 +1,139 @@
 #include "AnalyticalSolution.h"
 #include "HeatProblem.h"
 #include "Grid1D.h"
+#include "Telemetry.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace {
     // Local to this file only
     constexpr double pi = 3.14159265358979323846;
+
+    // Points evaluated together; the per-block recurrence state stays in L1
+    constexpr std::size_t block_size = 256;
 }
 
 AnalyticalSolution::AnalyticalSolution(const HeatProblem& problem,
-    std::size_t max_terms)
+    std::size_t max_terms, double tolerance)
     : problem_(problem),
-    max_terms_(max_terms) {
+    max_terms_(max_terms),
+    tolerance_(tolerance) {
 }
 
-double AnalyticalSolution::operator()(double x, double t) const {
+bool AnalyticalSolution::applies(const HeatProblem& problem) {
+    return problem.homogeneous();
+}
+
+void AnalyticalSolution::amplitudes(double t, std::vector<double>& a) const {
     const double D = problem_.diffusivity();
-    const double Tin = problem_.Tin();
-    const double Tsur = problem_.Tsur();
     const double L = problem_.grid().length();
 
-    double series = 0.0;
-
-    for (std::size_t m = 1; m <= max_terms_; ++m) {
+    // Even terms have coefficient (1 - (-1)^m) / (m pi) = 0 and are skipped
+    a.clear();
+    for (std::size_t m = 1; m <= max_terms_; m += 2) {
         double m_d = static_cast<double>(m);
         double mPiL = (m_d * pi) / L;
         double expo = std::exp(-D * mPiL * mPiL * t);
-        double coef = (1.0 - std::pow(-1.0, m_d)) / (m_d * pi);
-        double sine = std::sin(mPiL * x);
+        if (expo < tolerance_) {
+            break;
+        }
+        a.push_back(expo * 2.0 / (m_d * pi));
+    }
+}
+
+std::size_t AnalyticalSolution::terms_used(double t) const {
+    std::vector<double> a;
+    amplitudes(t, a);
+    return a.size();
+}
+
+double AnalyticalSolution::operator()(double x, double t) const {
+    HEAT_SCOPED_TIMER(AnalyticalReference, 1, 1, 8);
+
+    const double Tin = problem_.Tin();
+    const double Tsur = problem_.Tsur();
+    const double L = problem_.grid().length();
+
+    std::vector<double> a;
+    amplitudes(t, a);
 
-        series += expo * coef * sine;
+    // Same recurrence as evaluate(), for a single point
+    double theta = pi * x / L;
+    double s_cur = std::sin(theta);
+    double s_old = -s_cur;
+    double c = std::cos(theta);
+    double two_c2 = 2.0 * (c * c - s_cur * s_cur);
+
+    double series = 0.0;
+    for (double ak : a) {
+        series += ak * s_cur;
+        double s_next = two_c2 * s_cur - s_old;
+        s_old = s_cur;
+        s_cur = s_next;
     }
 
     return Tsur + 2.0 * (Tin - Tsur) * series;
 }
+
+void AnalyticalSolution::evaluate(const std::vector<double>& x, double t,
+    std::vector<double>& out) const {
+    out.resize(x.size());
+    evaluate(x.data(), x.size(), t, out.data());
+}
+
+void AnalyticalSolution::evaluate(const Grid1D& grid, double t,
+    std::vector<double>& out) const {
+    evaluate(grid.coords(), t, out);
+}
+
+void AnalyticalSolution::evaluate(const double* x, std::size_t n, double t,
+    double* out) const {
+    HEAT_SCOPED_TIMER(AnalyticalReference, 1, n, 16 * n);
+
+    const double Tin = problem_.Tin();
+    const double Tsur = problem_.Tsur();
+    const double L = problem_.grid().length();
+
+    std::vector<double> a;
+    amplitudes(t, a);
+    const std::size_t n_terms = a.size();
+
+    // For theta = pi x / L the odd sines obey
+    //   sin((m + 2) theta) = 2 cos(2 theta) sin(m theta) - sin((m - 2) theta)
+    // starting from sin(-theta) = -sin(theta).
+    alignas(64) double s_old[block_size];
+    alignas(64) double s_cur[block_size];
+    alignas(64) double two_c2[block_size];
+    alignas(64) double series[block_size];
+
+    for (std::size_t begin = 0; begin < n; begin += block_size) {
+        const std::size_t len = std::min(block_size, n - begin);
+
+        // The term loop always runs over a full block (padded with x = 0)
+        // so its trip count is a constant and it vectorizes at -O2
+        for (std::size_t i = 0; i < block_size; ++i) {
+            double theta = (i < len) ? pi * x[begin + i] / L : 0.0;
+            double s = std::sin(theta);
+            double c = std::cos(theta);
+            s_cur[i] = s;
+            s_old[i] = -s;
+            two_c2[i] = 2.0 * (c * c - s * s);
+            series[i] = 0.0;
+        }
+
+        for (std::size_t k = 0; k < n_terms; ++k) {
+            const double ak = a[k];
+            for (std::size_t i = 0; i < block_size; ++i) {
+                series[i] += ak * s_cur[i];
+                double s_next = two_c2[i] * s_cur[i] - s_old[i];
+                s_old[i] = s_cur[i];
+                s_cur[i] = s_next;
+            }
+        }
+
+        for (std::size_t i = 0; i < len; ++i) {
+            out[begin + i] = Tsur + 2.0 * (Tin - Tsur) * series[i];
+        }
+    }
+}
@@ -1,17 +1,47 @@
 #pragma once
 #include "HeatProblem.h"
 #include <cstddef>
+#include <vector>
 
+// Series solution for a homogeneous wall
 class AnalyticalSolution {
 public:
-    // Constructor: only HeatProblem + optional number of terms
+    // Constructor: HeatProblem + optional number of terms and truncation
+    // tolerance. Terms m > max_terms are never used; the series also stops
+    // at the first odd term whose decay factor exp(-D (m pi / L)^2 t) is
+    // below tolerance (all later terms are smaller still).
     AnalyticalSolution(const HeatProblem& problem,
-        std::size_t max_terms = 100);
+        std::size_t max_terms = 100,
+        double tolerance = 1e-16);
 
     // Evaluate T(x,t)
     double operator()(double x, double t) const;
 
+    // Evaluate T(x_i, t) for all points at once (out is resized).
+    // Sines come from a recurrence instead of per-term std::sin, so the
+    // cost is one sin/cos pair per point plus a few multiply-adds per term.
+    void evaluate(const std::vector<double>& x, double t,
+        std::vector<double>& out) const;
+
+    void evaluate(const Grid1D& grid, double t,
+        std::vector<double>& out) const;
+
+    // Number of (odd) series terms used at time t
+    std::size_t terms_used(double t) const;
+
+    // The series is the solution of homogeneous walls only; composite
+    // walls have no closed form here
+    static bool applies(const HeatProblem& problem);
+
 private:
+    // Amplitudes 2 / (m pi) * exp(-D (m pi / L)^2 t) of the odd terms
+    // m = 1, 3, 5, ... that survive truncation
+    void amplitudes(double t, std::vector<double>& a) const;
+
+    void evaluate(const double* x, std::size_t n, double t,
+        double* out) const;
+
     const HeatProblem& problem_;
     std::size_t max_terms_;
+    double tolerance_;
 };
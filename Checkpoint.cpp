@@ -0,0 +1,107 @@
+#include "Checkpoint.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+    struct CheckpointHeader {
+        char magic[8];                 // "HEATCKPT"
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t n_nodes;
+        std::uint64_t step;
+        double t;
+        double dt;
+        std::uint64_t scheme_bytes;
+        std::uint64_t state_bytes;
+    };
+
+    static_assert(sizeof(CheckpointHeader) == 64, "CheckpointHeader must be 64 bytes");
+
+    constexpr std::uint32_t checkpoint_version = 1;
+}
+
+void Checkpoint::write(const std::string& path) const
+{
+    if (T_prev.size() != T_curr.size()) {
+        throw std::runtime_error("Checkpoint::write: time levels differ in size");
+    }
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, "HEATCKPT", 8);
+    header.version = checkpoint_version;
+    header.n_nodes = T_curr.size();
+    header.step = step;
+    header.t = t;
+    header.dt = dt;
+    header.scheme_bytes = scheme.size();
+    header.state_bytes = scheme_state.size();
+
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open checkpoint file: " + temp);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(scheme.data(), static_cast<std::streamsize>(scheme.size()));
+        file.write(reinterpret_cast<const char*>(T_curr.data()),
+            static_cast<std::streamsize>(T_curr.size() * sizeof(double)));
+        file.write(reinterpret_cast<const char*>(T_prev.data()),
+            static_cast<std::streamsize>(T_prev.size() * sizeof(double)));
+        file.write(reinterpret_cast<const char*>(scheme_state.data()),
+            static_cast<std::streamsize>(scheme_state.size()));
+        file.close();
+        if (file.fail()) {
+            throw std::runtime_error("Checkpoint: write error on " + temp);
+        }
+    }
+
+    // std::rename replaces an existing target atomically on POSIX; Windows
+    // refuses to, so the old file goes first there
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Checkpoint: cannot rename " + temp + " to " + path);
+    }
+}
+
+Checkpoint Checkpoint::read(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open checkpoint file: " + path);
+    }
+
+    CheckpointHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, "HEATCKPT", 8) != 0) {
+        throw std::runtime_error("Not a checkpoint file: " + path);
+    }
+    if (header.version != checkpoint_version) {
+        throw std::runtime_error("Unsupported checkpoint version in " + path);
+    }
+
+    Checkpoint cp;
+    cp.step = header.step;
+    cp.t = header.t;
+    cp.dt = header.dt;
+    cp.scheme.resize(header.scheme_bytes);
+    cp.T_curr.resize(header.n_nodes);
+    cp.T_prev.resize(header.n_nodes);
+    cp.scheme_state.resize(header.state_bytes);
+
+    file.read(&cp.scheme[0], static_cast<std::streamsize>(cp.scheme.size()));
+    file.read(reinterpret_cast<char*>(cp.T_curr.data()),
+        static_cast<std::streamsize>(cp.T_curr.size() * sizeof(double)));
+    file.read(reinterpret_cast<char*>(cp.T_prev.data()),
+        static_cast<std::streamsize>(cp.T_prev.size() * sizeof(double)));
+    file.read(reinterpret_cast<char*>(cp.scheme_state.data()),
+        static_cast<std::streamsize>(cp.scheme_state.size()));
+    if (!file) {
+        throw std::runtime_error("Truncated checkpoint file: " + path);
+    }
+    return cp;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Complete state of a run after `step` steps: the two time levels a
+// restart needs, the time, and whatever the scheme keeps besides them
+// (TimeScheme::save_state).
+//
+// On-disk layout (native byte order):
+//
+//   header                          64 bytes: "HEATCKPT", version, n_nodes,
+//                                   step, t, dt and the two lengths below
+//   scheme id                       typeid name of the scheme
+//   T_curr, T_prev                  n_nodes float64 each
+//   scheme state                    opaque bytes
+//
+// write() goes through a temporary file that is renamed over `path`, so a
+// crash during a write leaves the previous checkpoint intact.
+struct Checkpoint {
+    std::uint64_t step = 0;
+    double t = 0.0;
+    double dt = 0.0;
+    std::string scheme;
+    std::vector<double> T_curr;
+    std::vector<double> T_prev;
+    std::vector<unsigned char> scheme_state;
+
+    void write(const std::string& path) const;
+    static Checkpoint read(const std::string& path);
+};
@@ -0,0 +1,111 @@
+#include "CheckpointWriter.h"
+#include "TimeLevels.h"
+#include "TimeScheme.h"
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+CheckpointWriter::CheckpointWriter(const std::string& path)
+    : path_(path),
+    writer_(&CheckpointWriter::writer_loop, this)
+{
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    try {
+        close();
+    }
+    catch (...) {
+        // Destructors must not throw; call close() to see I/O errors
+    }
+}
+
+void CheckpointWriter::submit(std::size_t step, double t, double dt,
+    const TimeLevels& levels, const TimeScheme& scheme)
+{
+    {
+        // Assignments reuse the capacity of the spare buffer
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            throw std::runtime_error("CheckpointWriter::submit: writer is closed");
+        }
+        if (has_pending_) {
+            ++superseded_;
+        }
+        pending_.step = step;
+        pending_.t = t;
+        pending_.dt = dt;
+        pending_.scheme = typeid(scheme).name();
+        pending_.T_curr = levels.curr();
+        pending_.T_prev = levels.prev();
+        scheme.save_state(pending_.scheme_state);
+        has_pending_ = true;
+    }
+    cv_.notify_one();
+}
+
+void CheckpointWriter::writer_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return has_pending_ || stopping_; });
+        if (!has_pending_) {
+            return;  // stopping with nothing left
+        }
+        std::swap(pending_, writing_);
+        has_pending_ = false;
+
+        lock.unlock();
+        std::string error;
+        try {
+            writing_.write(path_);
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        lock.lock();
+
+        if (error.empty()) {
+            ++written_;
+        }
+        else if (error_.empty()) {
+            error_ = error;
+        }
+    }
+}
+
+void CheckpointWriter::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    writer_.join();
+
+    if (!error_.empty()) {
+        throw std::runtime_error("CheckpointWriter: " + error_);
+    }
+}
+
+const std::string& CheckpointWriter::path() const
+{
+    return path_;
+}
+
+std::size_t CheckpointWriter::written() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+std::size_t CheckpointWriter::superseded() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return superseded_;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Checkpoint.h"
+
+class TimeLevels;
+class TimeScheme;
+
+// Writes checkpoints of a run to one file from a background thread.
+// submit() copies the state into a spare buffer and returns; while the
+// thread is still writing, a newer submission replaces the one waiting
+// behind it (counted by superseded()), so the solver never waits for the
+// disk and the file always ends up with the latest state. close() (or the
+// destructor) writes what is pending and stops the thread.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(std::size_t step, double t, double dt,
+        const TimeLevels& levels, const TimeScheme& scheme);
+
+    // Writes the pending checkpoint and stops; throws on I/O errors
+    void close();
+
+    const std::string& path() const;
+    std::size_t written() const;
+    std::size_t superseded() const;
+
+private:
+    void writer_loop();
+
+    std::string path_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    Checkpoint pending_;        // filled by submit()
+    bool has_pending_ = false;
+    bool stopping_ = false;
+    std::string error_;
+    std::size_t written_ = 0;
+    std::size_t superseded_ = 0;
+
+    Checkpoint writing_;        // writer thread only; swapped with pending_
+    bool closed_ = false;
+    std::thread writer_;
+};
@@ -0,0 +1,76 @@
+#include "ComparisonRunner.h"
+#include "AnalyticalSolution.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+#include <exception>
+#include <future>
+
+ComparisonRunner::ComparisonRunner(const HeatProblem& problem,
+    double dt, double t_end)
+    : problem_(problem), dt_(dt), t_end_(t_end)
+{
+}
+
+void ComparisonRunner::add_scheme(const std::string& name)
+{
+    add_scheme(name, [name](const HeatProblem& problem) {
+        return make_scheme(name, problem);
+    });
+}
+
+void ComparisonRunner::add_scheme(const std::string& name,
+    SchemeFactory factory)
+{
+    entries_.push_back({ name, std::move(factory) });
+}
+
+void ComparisonRunner::run(OutputManager& out, ThreadPool& pool)
+{
+    const Grid1D& grid = problem_.grid();
+
+    std::promise<std::vector<double>> exact_promise;
+    std::shared_future<std::vector<double>> exact =
+        exact_promise.get_future().share();
+
+    std::vector<std::future<void>> done;
+    done.reserve(entries_.size());
+
+    for (const Entry& entry : entries_) {
+        done.push_back(pool.submit([this, &entry, &grid, &out, exact]() {
+            Simulation sim(problem_, entry.factory(problem_), dt_, t_end_);
+            sim.run_to_end();
+            // Blocks until the caller has published the reference
+            out.store_scheme_result(entry.name, grid, sim.release_solution(),
+                exact.get());
+        }));
+    }
+
+    // Reference at the exact time the schemes reach, computed here so a
+    // pool task never waits on work that is queued behind it
+    try {
+        const double t = Simulation::end_time(dt_, t_end_);
+        std::vector<double> T_exact;  // stays empty for composite walls
+        if (AnalyticalSolution::applies(problem_)) {
+            AnalyticalSolution(problem_).evaluate(grid, t, T_exact);
+        }
+        exact_promise.set_value(std::move(T_exact));
+    }
+    catch (...) {
+        exact_promise.set_exception(std::current_exception());
+    }
+
+    std::exception_ptr first_error;
+    for (std::future<void>& f : done) {
+        try {
+            f.get();
+        }
+        catch (...) {
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "HeatProblem.h"
+#include "TimeScheme.h"
+#include "OutputManager.h"
+#include "ThreadPool.h"
+
+// Runs several schemes on the same problem concurrently, one pool task per
+// scheme. The analytical reference is computed once (on the calling thread,
+// while the schemes march) and shared by all of them.
+class ComparisonRunner {
+public:
+    using SchemeFactory =
+        std::function<std::unique_ptr<TimeScheme>(const HeatProblem&)>;
+
+    ComparisonRunner(const HeatProblem& problem, double dt, double t_end);
+
+    // Built-in scheme by name (see make_scheme)
+    void add_scheme(const std::string& name);
+
+    // Any scheme; name is what the result is stored under
+    void add_scheme(const std::string& name, SchemeFactory factory);
+
+    // Marches all registered schemes and stores their results in out.
+    // Rethrows the first failure after every task has finished.
+    void run(OutputManager& out, ThreadPool& pool = ThreadPool::shared());
+
+private:
+    struct Entry {
+        std::string name;
+        SchemeFactory factory;
+    };
+
+    const HeatProblem& problem_;
+    double dt_;
+    double t_end_;
+    std::vector<Entry> entries_;
+};
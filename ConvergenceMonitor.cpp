@@ -0,0 +1,59 @@
+#include "ConvergenceMonitor.h"
+#include <cmath>
+#include <stdexcept>
+
+ConvergenceMonitor::ConvergenceMonitor(double tolerance, std::size_t steps)
+    : tolerance_(tolerance),
+    steps_(steps)
+{
+    if (!(tolerance > 0.0)) {
+        throw std::runtime_error("ConvergenceMonitor: tolerance must be positive");
+    }
+    if (steps == 0) {
+        throw std::runtime_error("ConvergenceMonitor: steps must be positive");
+    }
+}
+
+void ConvergenceMonitor::start(const HeatProblem& /*problem*/, std::size_t /*step*/,
+    double /*t*/, const std::vector<double>& /*T*/)
+{
+    quiet_ = 0;
+    converged_ = false;
+    step_ = 0;
+    time_ = 0.0;
+    last_change_ = 0.0;
+}
+
+void ConvergenceMonitor::observe(const Observation& observation)
+{
+    last_change_ = observation.stats.max_change;
+    if (converged_) {
+        return;
+    }
+    quiet_ = (std::isfinite(last_change_) && last_change_ < tolerance_) ? quiet_ + 1 : 0;
+    if (quiet_ >= steps_) {
+        converged_ = true;
+        step_ = observation.step;
+        time_ = observation.t;
+    }
+}
+
+bool ConvergenceMonitor::converged() const
+{
+    return converged_;
+}
+
+std::size_t ConvergenceMonitor::step() const
+{
+    return step_;
+}
+
+double ConvergenceMonitor::time() const
+{
+    return time_;
+}
+
+double ConvergenceMonitor::last_change() const
+{
+    return last_change_;
+}
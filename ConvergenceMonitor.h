@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include "Observer.h"
+
+// Ends a run at steady state: converged once the max change
+// |T^{n+1} - T^n| over the interior nodes has stayed below tolerance for
+// `steps` observed steps in a row. A single quiet step is not enough: the
+// start-up step of the explicit schemes changes nothing in the interior,
+// since the initial condition still holds Tin at the walls. A non-finite
+// change (a diverged run) never counts. The change per step scales with
+// dt, so the tolerance refers to the run's dt.
+// Costs nothing beyond the fused StepStatistics; register it every step.
+class ConvergenceMonitor : public Observer {
+public:
+    explicit ConvergenceMonitor(double tolerance, std::size_t steps = 3);
+
+    void start(const HeatProblem& problem, std::size_t step, double t,
+        const std::vector<double>& T) override;
+    void observe(const Observation& observation) override;
+    bool converged() const override;
+
+    // Step index and time of convergence (0 if not converged)
+    std::size_t step() const;
+    double time() const;
+
+    // Max change of the last observed step
+    double last_change() const;
+
+private:
+    double tolerance_;
+    std::size_t steps_;
+    std::size_t quiet_ = 0;  // observed steps below tolerance in a row
+    bool converged_ = false;
+    std::size_t step_ = 0;
+    double time_ = 0.0;
+    double last_change_ = 0.0;
+};
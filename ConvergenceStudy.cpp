@@ -0,0 +1,225 @@
+#include "ConvergenceStudy.h"
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    constexpr double not_a_number = std::numeric_limits<double>::quiet_NaN();
+
+    struct Run {
+        ConvergenceLevel result;
+        std::vector<double> x;
+        std::vector<double> T;
+        std::vector<double> T_exact;
+    };
+
+    void errors(const std::vector<double>& T, const std::vector<double>& T_exact,
+        double dx, double length, double& l2, double& linf)
+    {
+        double sum_sq = 0.0;
+        linf = 0.0;
+        for (std::size_t i = 0; i < T.size(); ++i) {
+            double e = std::abs(T[i] - T_exact[i]);
+            sum_sq += e * e;
+            linf = std::max(linf, e);
+        }
+        l2 = std::sqrt(sum_sq * dx / length);
+    }
+
+    // Extrapolates the fine and coarse runs at the coarse nodes; returns
+    // false if the fine grid does not contain every coarse node
+    bool extrapolate(const Run& coarse, const Run& fine, double order,
+        double length, double& l2, double& linf)
+    {
+        const std::size_t n = coarse.T.size();
+        if (fine.T.size() < 2 * (n - 1) + 1) {
+            return false;
+        }
+        const double tol = 1e-9 * coarse.result.dx;
+        const double factor = 1.0 / (std::pow(2.0, order) - 1.0);
+
+        std::vector<double> T(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (std::abs(fine.x[2 * i] - coarse.x[i]) > tol) {
+                return false;
+            }
+            T[i] = fine.T[2 * i] + (fine.T[2 * i] - coarse.T[i]) * factor;
+        }
+        errors(T, coarse.T_exact, coarse.result.dx, length, l2, linf);
+        return true;
+    }
+}
+
+ConvergenceStudy::ConvergenceStudy(const ConvergenceOptions& options)
+    : options_(options)
+{
+    if (options_.levels == 0 || options_.dx <= 0.0 || options_.dt <= 0.0
+        || options_.dt_ratio <= 0.0) {
+        throw std::runtime_error("ConvergenceStudy: levels, dx, dt and dt_ratio must be positive");
+    }
+}
+
+std::vector<ConvergenceLevel> ConvergenceStudy::run(ThreadPool& pool) const
+{
+    const ConvergenceOptions& o = options_;
+    const std::size_t n_schemes = o.schemes.size();
+    std::vector<Run> runs(n_schemes * o.levels);
+
+    for (std::size_t s = 0; s < n_schemes; ++s) {
+        for (std::size_t k = 0; k < o.levels; ++k) {
+            ConvergenceLevel& r = runs[s * o.levels + k].result;
+            r.scheme = o.schemes[s];
+            r.level = k;
+            r.dx = o.dx / std::pow(2.0, static_cast<double>(k));
+            r.dt = o.dt / std::pow(o.dt_ratio, static_cast<double>(k));
+            r.nodes = static_cast<std::size_t>(o.length / r.dx) + 1;
+            r.steps = static_cast<std::size_t>(std::round(o.t_end / r.dt));
+        }
+    }
+
+    // Largest runs first
+    std::vector<std::size_t> order(runs.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return runs[a].result.nodes * runs[a].result.steps
+             > runs[b].result.nodes * runs[b].result.steps;
+    });
+
+    std::vector<std::future<void>> done;
+    done.reserve(runs.size());
+    for (std::size_t index : order) {
+        done.push_back(pool.submit([&o, &runs, index] {
+            Run& run = runs[index];
+            ConvergenceLevel& r = run.result;
+            auto start = std::chrono::steady_clock::now();
+
+            Grid1D grid(o.length, r.dx);
+            HeatProblem problem(grid, o.D, o.Tin, o.Tsur);
+            Simulation sim(problem, make_scheme(r.scheme, problem), r.dt, o.t_end);
+            double t = sim.run_to_end();
+
+            run.x = grid.coords();
+            run.T = sim.release_solution();
+            AnalyticalSolution(problem).evaluate(grid, t, run.T_exact);
+            errors(run.T, run.T_exact, r.dx, o.length, r.l2_error, r.linf_error);
+
+            r.nodes = grid.size();
+            r.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        }));
+    }
+    for (std::future<void>& f : done) {
+        f.get();
+    }
+
+    // Orders and extrapolation need neighbouring levels
+    std::vector<ConvergenceLevel> results;
+    results.reserve(runs.size());
+    for (std::size_t s = 0; s < n_schemes; ++s) {
+        for (std::size_t k = 0; k < o.levels; ++k) {
+            ConvergenceLevel r = runs[s * o.levels + k].result;
+            r.l2_order = r.linf_order = not_a_number;
+            r.extrapolated_l2 = r.extrapolated_linf = not_a_number;
+
+            if (k > 0) {
+                const Run& coarse = runs[s * o.levels + k - 1];
+                const ConvergenceLevel& c = coarse.result;
+                r.l2_order = std::log(c.l2_error / r.l2_error) / std::log(2.0);
+                r.linf_order = std::log(c.linf_error / r.linf_error) / std::log(2.0);
+
+                const bool smooth = std::find(o.extrapolated_schemes.begin(),
+                    o.extrapolated_schemes.end(), r.scheme) != o.extrapolated_schemes.end();
+                double l2, linf;
+                if (smooth && extrapolate(coarse, runs[s * o.levels + k], o.extrapolation_order,
+                    o.length, l2, linf)) {
+                    r.extrapolated_l2 = l2;
+                    r.extrapolated_linf = linf;
+                }
+            }
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+void ConvergenceStudy::print_table(const std::vector<ConvergenceLevel>& results,
+    std::ostream& out)
+{
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "scheme         lvl        dx          dt    nodes     steps"
+        << "    L2 error  order   Linf error  order  extrap. L2  extrap. Linf\n";
+    for (const ConvergenceLevel& r : results) {
+        out << std::left << std::setw(15) << r.scheme << std::right
+            << std::setw(3) << r.level
+            << std::scientific << std::setprecision(3)
+            << std::setw(12) << r.dx
+            << std::setw(12) << r.dt
+            << std::setw(9) << r.nodes
+            << std::setw(10) << r.steps
+            << std::setw(12) << r.l2_error
+            << std::fixed << std::setprecision(2) << std::setw(7) << r.l2_order
+            << std::scientific << std::setprecision(3) << std::setw(13) << r.linf_error
+            << std::fixed << std::setprecision(2) << std::setw(7) << r.linf_order
+            << std::scientific << std::setprecision(3)
+            << std::setw(12) << r.extrapolated_l2
+            << std::setw(14) << r.extrapolated_linf << "\n";
+    }
+    for (const ConvergenceLevel& r : results) {
+        if (r.level == 1 && std::isnan(r.extrapolated_l2)) {
+            out << r.scheme << ": not extrapolated (error not a smooth C dx^p,"
+                << " or the grids do not nest)\n";
+        }
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void ConvergenceStudy::write_csv(const std::vector<ConvergenceLevel>& results,
+    const std::string& filename)
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open output file: " + filename);
+    }
+
+    file << "scheme,level,dx (cm),dt (hr),nodes,steps,seconds,"
+        << "l2_error,l2_order,linf_error,linf_order,"
+        << "extrapolated_l2_error,extrapolated_linf_error\n";
+
+    file << std::setprecision(10);
+    for (const ConvergenceLevel& r : results) {
+        file << r.scheme << ","
+            << r.level << ","
+            << r.dx << ","
+            << r.dt << ","
+            << r.nodes << ","
+            << r.steps << ","
+            << r.seconds << ","
+            << r.l2_error << ","
+            << r.l2_order << ","
+            << r.linf_error << ","
+            << r.linf_order << ","
+            << r.extrapolated_l2 << ","
+            << r.extrapolated_linf << "\n";
+    }
+
+    file.close();
+
+    std::cout << "Convergence study written to: " << filename << "\n";
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ThreadPool.h"
+
+struct ConvergenceOptions {
+    double length = 31.0;   // cm
+    double D = 93.0;        // cm^2/hr
+    double Tin = 38.0;
+    double Tsur = 149.0;
+    double t_end = 0.5;     // hr
+
+    // Level 0; every further level halves dx and divides dt by dt_ratio
+    // (4 keeps r = D dt / dx^2 fixed, so every scheme converges as dx^2)
+    // (dx should divide the length so that the last node sits on the wall)
+    double dx = 0.5;
+    double dt = 1e-3;
+    double dt_ratio = 4.0;
+    std::size_t levels = 5;
+
+    // Order in dx assumed by the Richardson extrapolation
+    double extrapolation_order = 2.0;
+
+    std::vector<std::string> schemes = { "DuFortFrankel", "Laasonen", "CrankNicolson" };
+
+    // Schemes whose pointwise error is a smooth C dx^p, the premise of the
+    // extrapolation. DuFort-Frankel converges at order 2 in the norms, but
+    // its start-up step and three-level coupling leave a node-to-node
+    // error pattern: extrapolating it is worse than the finer level.
+    std::vector<std::string> extrapolated_schemes = { "Laasonen", "CrankNicolson" };
+};
+
+struct ConvergenceLevel {
+    std::string scheme;
+    std::size_t level = 0;
+    double dx = 0.0;
+    double dt = 0.0;
+    std::size_t nodes = 0;
+    std::size_t steps = 0;
+    double seconds = 0.0;
+
+    // Against AnalyticalSolution at all nodes
+    double l2_error = 0.0;     // sqrt(sum e^2 dx / L)
+    double linf_error = 0.0;
+
+    // log(e_coarser / e) / log 2; NaN on level 0
+    double l2_order = 0.0;
+    double linf_order = 0.0;
+
+    // Richardson extrapolation of this level and the one below, on the
+    // coarser level's nodes; NaN on level 0, if the grids do not nest or
+    // for schemes not in extrapolated_schemes
+    double extrapolated_l2 = 0.0;
+    double extrapolated_linf = 0.0;
+};
+
+// Runs every scheme on a hierarchy of refined grid / dt pairs, all runs
+// concurrently (largest first), and reports errors, observed orders and
+// Richardson-extrapolated errors. For the implicit schemes the extrapolated
+// value of levels k-1 and k is orders of magnitude more accurate than level
+// k+1, at a fraction of its cost.
+class ConvergenceStudy {
+public:
+    explicit ConvergenceStudy(const ConvergenceOptions& options = ConvergenceOptions());
+
+    // Results ordered by scheme, then level
+    std::vector<ConvergenceLevel> run(ThreadPool& pool = ThreadPool::shared()) const;
+
+    static void print_table(const std::vector<ConvergenceLevel>& results,
+        std::ostream& out);
+    static void write_csv(const std::vector<ConvergenceLevel>& results,
+        const std::string& filename);
+
+private:
+    ConvergenceOptions options_;
+};
@@ -1,16 +1,12 @@
 #pragma once
-#include <vector>
-#include "TimeScheme.h"
+#include "ThetaScheme.h"
 
-class CrankNicolsonScheme : public TimeScheme {
-public:
-    explicit CrankNicolsonScheme(const HeatProblem& problem);
+// Crank-Nicolson (trapezoidal rule in time)
+struct CrankNicolsonMethod {
+    static constexpr double theta = 0.5;
+};
 
-    void step(std::vector<double>& T_curr,
-        std::vector<double>& T_prev,
-        double t, double dt) override;
-
-private:
-    std::vector<double> a_, b_, c_;
-}; 
+using CrankNicolsonScheme = ThetaScheme<CrankNicolsonMethod>;
 
+extern template class ThetaScheme<CrankNicolsonMethod>;
+extern template class SchemeBase<CrankNicolsonScheme>;
@@ -0,0 +1,117 @@
+#include "DiagnosticsRecorder.h"
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+DiagnosticsRecorder::DiagnosticsRecorder(bool with_errors)
+    : with_errors_(with_errors) {
+}
+
+void DiagnosticsRecorder::start(const HeatProblem& problem, std::size_t step,
+    double t, const std::vector<double>& T)
+{
+    const Grid1D& grid = problem.grid();
+    if (grid.size() < 3) {
+        throw std::runtime_error("DiagnosticsRecorder: grid too small (N < 3)");
+    }
+    if (with_errors_ && !problem.homogeneous()) {
+        throw std::runtime_error("DiagnosticsRecorder: errors need a homogeneous wall");
+    }
+    problem_ = &problem;
+    records_.clear();
+
+    std::vector<double> D_face;
+    problem.face_diffusivities(D_face);
+    D_left_ = D_face.front();
+    D_right_ = D_face.back();
+
+    const std::vector<double>& x = grid.coords();
+    const double xc = 0.5 * grid.length();
+    auto it = std::upper_bound(x.begin(), x.end(), xc);
+    center_ = std::min<std::size_t>(it - x.begin(), x.size() - 1) - 1;
+    center_weight_ = std::min(1.0, (xc - x[center_]) / (x[center_ + 1] - x[center_]));
+
+    record(step, t, T, nullptr);
+}
+
+void DiagnosticsRecorder::observe(const Observation& observation)
+{
+    record(observation.step, observation.t, observation.T, &observation.stats);
+}
+
+void DiagnosticsRecorder::record(std::size_t step, double t,
+    const std::vector<double>& T, const StepStatistics* stats)
+{
+    const Grid1D& grid = problem_->grid();
+    const std::size_t N = grid.size();
+
+    DiagnosticsRecord r;
+    r.step = step;
+    r.t = t;
+    r.center = (1.0 - center_weight_) * T[center_] + center_weight_ * T[center_ + 1];
+    r.flux_left = -D_left_ * (T[1] - T[0]) / (grid.x(1) - grid.x(0));
+    r.flux_right = D_right_ * (T[N - 1] - T[N - 2]) / (grid.x(N - 1) - grid.x(N - 2));
+
+    if (stats && grid.uniform()) {
+        r.heat_content = grid.dx() * (stats->sum + 0.5 * (T[0] + T[N - 1]));
+    }
+    else {
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            r.heat_content += 0.5 * (grid.x(i + 1) - grid.x(i)) * (T[i] + T[i + 1]);
+        }
+    }
+    r.max_change = stats ? stats->max_change : 0.0;
+
+    if (with_errors_) {
+        AnalyticalSolution(*problem_).evaluate(grid, t, T_exact_);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            const double e = T[i] - T_exact_[i];
+            const double width = 0.5 * (grid.x(std::min(i + 1, N - 1)) - grid.x(i > 0 ? i - 1 : 0));
+            sum += e * e * width;
+            r.linf_error = std::max(r.linf_error, std::abs(e));
+        }
+        r.l2_error = std::sqrt(sum / grid.length());
+    }
+    else {
+        r.l2_error = std::numeric_limits<double>::quiet_NaN();
+        r.linf_error = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    records_.push_back(r);
+}
+
+const std::vector<DiagnosticsRecord>& DiagnosticsRecorder::records() const
+{
+    return records_;
+}
+
+void DiagnosticsRecorder::write_csv(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open output file: " + filename);
+    }
+
+    file << "step,t (hr),center,heat_content,flux_left,flux_right,"
+        << "max_change,l2_error,linf_error\n";
+
+    file << std::setprecision(10);
+    for (const DiagnosticsRecord& r : records_) {
+        file << r.step << ","
+            << r.t << ","
+            << r.center << ","
+            << r.heat_content << ","
+            << r.flux_left << ","
+            << r.flux_right << ","
+            << r.max_change << ","
+            << r.l2_error << ","
+            << r.linf_error << "\n";
+    }
+}
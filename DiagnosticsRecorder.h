@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Observer.h"
+
+struct DiagnosticsRecord {
+    std::size_t step = 0;
+    double t = 0.0;
+    double center = 0.0;        // T at x = L / 2 (linear interpolation)
+    double heat_content = 0.0;  // trapezoidal integral of T over the wall
+    double flux_left = 0.0;     // -D dT/dx at x = 0, positive into the wall
+    double flux_right = 0.0;    // D dT/dx at x = L, positive into the wall
+                                // (D of the first/last grid segment)
+    double max_change = 0.0;    // max |T^{n+1} - T^n| of the step (0 at start)
+
+    // Against AnalyticalSolution, sqrt(int e^2 dx / L) and max |e|;
+    // NaN unless the recorder was created with errors enabled
+    double l2_error = 0.0;
+    double linf_error = 0.0;
+};
+
+// Time series of wall diagnostics, one record at the start of a run and
+// one per observation. Center temperature and fluxes read a few nodes; on
+// a uniform grid the heat content comes from the fused sum of the step.
+// The errors need the analytical solution at every node and cost far more
+// than a step: enable them only with a coarse observation interval (and
+// only for a homogeneous wall).
+class DiagnosticsRecorder : public Observer {
+public:
+    explicit DiagnosticsRecorder(bool with_errors = false);
+
+    void start(const HeatProblem& problem, std::size_t step, double t,
+        const std::vector<double>& T) override;
+    void observe(const Observation& observation) override;
+
+    const std::vector<DiagnosticsRecord>& records() const;
+
+    void write_csv(const std::string& filename) const;
+
+private:
+    void record(std::size_t step, double t, const std::vector<double>& T,
+        const StepStatistics* stats);
+
+    bool with_errors_;
+    const HeatProblem* problem_ = nullptr;
+    std::size_t center_ = 0;        // center lies in [x_c, x_c+1]
+    double center_weight_ = 0.0;    // of node center_ + 1
+    double D_left_ = 0.0;           // face diffusivities at the walls
+    double D_right_ = 0.0;
+    std::vector<double> T_exact_;
+    std::vector<DiagnosticsRecord> records_;
+};
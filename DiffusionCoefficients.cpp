@@ -0,0 +1,45 @@
+#include "DiffusionCoefficients.h"
+#include "HeatProblem.h"
+#include "Grid1D.h"
+
+void DiffusionCoefficients::update(const HeatProblem& problem, double dt)
+{
+    if (&problem != problem_) {
+        problem.face_diffusivities(D_face_);
+        problem_ = &problem;
+        dt_ = 0.0;
+    }
+    if (dt == dt_) {
+        return;
+    }
+
+    const Grid1D& grid = problem.grid();
+    const std::size_t N = grid.size();
+    left_.assign(N, 0.0);
+    right_.assign(N, 0.0);
+
+    if (grid.uniform()) {
+        const double w = 1.0 / (grid.dx() * grid.dx());
+        for (std::size_t i = 1; i + 1 < N; ++i) {
+            left_[i] = dt * D_face_[i - 1] * w;
+            right_[i] = dt * D_face_[i] * w;
+        }
+    }
+    else {
+        const std::vector<double>& wl = grid.laplacian_left();
+        const std::vector<double>& wr = grid.laplacian_right();
+        for (std::size_t i = 1; i + 1 < N; ++i) {
+            left_[i] = dt * D_face_[i - 1] * wl[i];
+            right_[i] = dt * D_face_[i] * wr[i];
+        }
+    }
+    dt_ = dt;
+}
+
+const double* DiffusionCoefficients::left() const {
+    return left_.data();
+}
+
+const double* DiffusionCoefficients::right() const {
+    return right_.data();
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+
+class HeatProblem;
+
+// Per-node weights of dt times the diffusion operator, kept as two arrays,
+//     dt (D T')'(x_i) ~ left[i] (T[i-1] - T[i]) + right[i] (T[i+1] - T[i]),
+// with left[i] = dt D_{i-1/2} w_left[i] and right[i] = dt D_{i+1/2} w_right[i]:
+// D at the faces from HeatProblem::face_diffusivities(), w the Grid1D
+// weights (1 / dx^2 on a uniform grid). Entries 0 and N - 1 are zero.
+//
+// Built for the variable-coefficient path of the schemes; the face
+// diffusivities are computed once, the arrays once per dt.
+class DiffusionCoefficients {
+public:
+    // Recomputes the arrays if dt (or the problem) changed
+    void update(const HeatProblem& problem, double dt);
+
+    const double* left() const;
+    const double* right() const;
+
+private:
+    const HeatProblem* problem_ = nullptr;
+    double dt_ = 0.0;  // 0 = not computed yet
+    std::vector<double> D_face_;
+    std::vector<double> left_;
+    std::vector<double> right_;
+};
@@ -0,0 +1,76 @@
+#include "DistributedSimulation.h"
+#include "Grid1D.h"
+#include "SharedMemoryTransport.h"
+#include "SubdomainSimulation.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+DistributedSimulation::DistributedSimulation(const HeatProblem& problem,
+    const std::string& scheme_name,
+    double dt, double t_end,
+    std::size_t n_ranks)
+    : problem_(problem),
+    scheme_name_(scheme_name),
+    dt_(dt),
+    t_end_(t_end),
+    n_ranks_(n_ranks)
+{
+    if (n_ranks_ == 0) {
+        throw std::runtime_error("DistributedSimulation: need at least one rank");
+    }
+    // Fail here rather than once per forked rank (SubdomainSimulation checks
+    // the rest, which is the same on every rank)
+    const Grid1D& grid = problem.grid();
+    if (!problem.constant_coefficients() || grid.size() < 2 * n_ranks_ + 2) {
+        throw std::runtime_error("DistributedSimulation: the grid cannot be split over "
+            + std::to_string(n_ranks_) + " ranks");
+    }
+}
+
+double DistributedSimulation::run_to_end()
+{
+    SharedMemoryTransport transport(n_ranks_);
+    std::cout.flush();
+    const std::size_t rank = transport.launch();
+
+    if (rank != 0) {
+        // Worker process: never return into the caller's code
+        int status = 0;
+        try {
+            SubdomainSimulation sub(problem_, scheme_name_, dt_, t_end_, transport);
+            sub.run_to_end();
+            sub.gather(solution_);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "rank " << rank << ": " << e.what() << "\n";
+            transport.abort();
+            status = 1;
+        }
+        std::_Exit(status);
+    }
+
+    double t = 0.0;
+    try {
+        SubdomainSimulation sub(problem_, scheme_name_, dt_, t_end_, transport);
+        t = sub.run_to_end();
+        sub.gather(solution_);
+    }
+    catch (...) {
+        transport.abort();
+        try {
+            transport.join();
+        }
+        catch (...) {
+            // Report the first failure
+        }
+        throw;
+    }
+    transport.join();
+    return t;
+}
+
+const std::vector<double>& DistributedSimulation::solution() const
+{
+    return solution_;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "HeatProblem.h"
+
+// Runs a SubdomainSimulation on n_ranks processes of this machine: the
+// calling process is rank 0, the others are forked from it and talk
+// through a SharedMemoryTransport. The workers only march and send their
+// nodes back; they use no thread pool (the parent's may already be
+// running, and its threads are not forked) and leave with std::_Exit.
+class DistributedSimulation {
+public:
+    DistributedSimulation(const HeatProblem& problem,
+        const std::string& scheme_name,
+        double dt, double t_end,
+        std::size_t n_ranks);
+
+    // Marches to t_end on all ranks and gathers the solution; returns
+    // the time reached. Throws if any rank fails.
+    double run_to_end();
+
+    const std::vector<double>& solution() const;
+
+private:
+    const HeatProblem& problem_;
+    std::string scheme_name_;
+    double dt_;
+    double t_end_;
+    std::size_t n_ranks_;
+    std::vector<double> solution_;
+};
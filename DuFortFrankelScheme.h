@@ -1,15 +1,31 @@
 #pragma once
-#include "TimeScheme.h"
-#include <vector>
+#include "ExplicitScheme.h"
 
-class DuFortFrankelScheme : public TimeScheme {
-public:
-    explicit DuFortFrankelScheme(const HeatProblem& problem);
+// DuFort-Frankel (Hoffmann):
+//     (1 + 2r) T^{n+1} = (1 - 2r) T^{n-1} + 2r (T_{i-1} + T_{i+1}),
+// with an FTCS start-up step that sees Tsur beyond the wall-adjacent nodes
+struct DuFortFrankelMethod {
+    template <class Real>
+    static BasicDuFortFrankelStencil<Real> stencil(Real r)
+    {
+        return { Real(1.0) - Real(2.0) * r, Real(2.0) * r, Real(1.0) + Real(2.0) * r };
+    }
 
-    void step(std::vector<double>& T_curr,
-        std::vector<double>& T_prev,
-        double t, double dt) override;
+    static constexpr StartUp start_up = StartUp::FirstStep;
+    template <class Real>
+    static BasicLaplacianUpdateStencil<Real> start_up_stencil(Real r) { return { r }; }
 
-private:
-    bool first_step_ = true;  // needed for the very first time step
+    // With s = kl + kr:
+    //     (1 + s) T^{n+1} = (1 - s) T^{n-1} + 2 (kl T_{i-1} + kr T_{i+1})
+    static double update(double kl, double kr, double left, double /*centre*/,
+        double right, double prev)
+    {
+        double s = kl + kr;
+        return ((1.0 - s) * prev + 2.0 * (kl * left + kr * right)) / (1.0 + s);
+    }
 };
+
+using DuFortFrankelScheme = ExplicitScheme<DuFortFrankelMethod>;
+
+extern template class ExplicitScheme<DuFortFrankelMethod>;
+extern template class SchemeBase<DuFortFrankelScheme>;
@@ -0,0 +1,329 @@
+#include "EnsembleSimulation.h"
+#include "AnalyticalSolution.h"
+#include "HeatProblem.h"
+#include "SchemeMethods.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr std::size_t L = EnsembleSimulation::lanes;
+
+    // The values of one node for the L walls of a block, with the
+    // arithmetic of double lane by lane (see SimdLanes.h), so that the
+    // Stencils.h expressions of a method run on whole blocks with one
+    // weight per wall. GCC and Clang keep a block in vector registers.
+    struct WallLanes {
+#if defined(__GNUC__) || defined(__clang__)
+        typedef double Values __attribute__((vector_size(L * sizeof(double)),
+            aligned(alignof(double))));
+#else
+        typedef double Values[L];
+#endif
+        Values v;
+
+        WallLanes() = default;
+        HEAT_INLINE WallLanes(double x) {
+            for (std::size_t w = 0; w < L; ++w) v[w] = x;
+        }
+        HEAT_INLINE static WallLanes load(const double* p) {
+            WallLanes x;
+            std::memcpy(&x.v, p, sizeof(Values));
+            return x;
+        }
+        HEAT_INLINE void store(double* p) const {
+            std::memcpy(p, &v, sizeof(Values));
+        }
+    };
+
+#if defined(__GNUC__) || defined(__clang__)
+    HEAT_INLINE WallLanes operator+(WallLanes a, const WallLanes& b) { a.v += b.v; return a; }
+    HEAT_INLINE WallLanes operator-(WallLanes a, const WallLanes& b) { a.v -= b.v; return a; }
+    HEAT_INLINE WallLanes operator*(WallLanes a, const WallLanes& b) { a.v *= b.v; return a; }
+    HEAT_INLINE WallLanes operator/(WallLanes a, const WallLanes& b) { a.v /= b.v; return a; }
+#else
+    template <class Op>
+    HEAT_INLINE WallLanes lane_wise(WallLanes a, const WallLanes& b, Op op)
+    {
+        for (std::size_t w = 0; w < L; ++w) a.v[w] = op(a.v[w], b.v[w]);
+        return a;
+    }
+    HEAT_INLINE WallLanes operator+(const WallLanes& a, const WallLanes& b) {
+        return lane_wise(a, b, [](double x, double y) { return x + y; });
+    }
+    HEAT_INLINE WallLanes operator-(const WallLanes& a, const WallLanes& b) {
+        return lane_wise(a, b, [](double x, double y) { return x - y; });
+    }
+    HEAT_INLINE WallLanes operator*(const WallLanes& a, const WallLanes& b) {
+        return lane_wise(a, b, [](double x, double y) { return x * y; });
+    }
+    HEAT_INLINE WallLanes operator/(const WallLanes& a, const WallLanes& b) {
+        return lane_wise(a, b, [](double x, double y) { return x / y; });
+    }
+#endif
+
+    // Rows [first, last) of a level, row i at [i * L]
+    template <class Stencil>
+    void sweep(const Stencil& s, double* next, const double* curr,
+        const double* prev, std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i) {
+            const WallLanes centre = WallLanes::load(curr + i * L);
+            const WallLanes left = WallLanes::load(curr + (i - 1) * L);
+            const WallLanes right = WallLanes::load(curr + (i + 1) * L);
+            if constexpr (Stencil::reads_prev) {
+                s(left, centre, right, WallLanes::load(prev + i * L)).store(next + i * L);
+            }
+            else {
+                s(left, centre, right, centre).store(next + i * L);
+            }
+        }
+    }
+
+    void set_walls(double* next, std::size_t N, const WallLanes& Tsur)
+    {
+        Tsur.store(next);
+        Tsur.store(next + (N - 1) * L);
+    }
+
+    // Step of an explicit method; first_step selects the start-up rule
+    template <class Method>
+    void explicit_step(double* next, const double* curr, const double* prev,
+        std::size_t N, const WallLanes& r, const WallLanes& Tsur, bool first_step)
+    {
+        set_walls(next, N, Tsur);
+
+        if constexpr (Method::start_up != StartUp::None) {
+            if (first_step) {
+                const auto s = Method::start_up_stencil(r);
+                if (Method::start_up != StartUp::FirstStep) {
+                    sweep(s, next, curr, nullptr, 1, N - 1);
+                    return;
+                }
+                // Tsur as the outer neighbour of the wall-adjacent nodes
+                sweep(s, next, curr, nullptr, 2, N - 2);
+                const WallLanes first = WallLanes::load(curr + L);
+                const WallLanes last = WallLanes::load(curr + (N - 2) * L);
+                s(Tsur, first, N > 3 ? WallLanes::load(curr + 2 * L) : Tsur, first)
+                    .store(next + L);
+                s(N > 3 ? WallLanes::load(curr + (N - 3) * L) : Tsur, last, Tsur, last)
+                    .store(next + (N - 2) * L);
+                return;
+            }
+        }
+        (void)first_step;
+        sweep(Method::stencil(r), next, curr, prev, 1, N - 1);
+    }
+
+    // Step of a theta method: right-hand side with the weights (1 - theta) r
+    // on the neighbours and theta r on Tsur in the wall rows, then batched
+    // Thomas sweeps with the prefactored lane matrices. The three time
+    // levels of a block never overlap; __restrict lets the compiler
+    // vectorize the lane loops.
+    template <class Method>
+    void theta_step(double* __restrict next,
+        const double* __restrict curr,
+        std::size_t N, const WallLanes& r, const WallLanes& Tsur,
+        const std::array<double, L>& sub,
+        const double* __restrict c_prime,
+        const double* __restrict inv_pivot)
+    {
+        constexpr double theta = Method::theta;
+        set_walls(next, N, Tsur);
+
+        const std::size_t n_int = N - 2;
+        double* rhs = next + L;  // interior rows 1..N-2
+
+        if constexpr (theta == 1.0) {
+            std::copy(curr + L, curr + (N - 1) * L, rhs);
+        }
+        else {
+            const WallLanes b = WallLanes(1.0 - theta) * r;
+            sweep(BasicThreePointStencil<WallLanes>{ b, WallLanes(1.0) - WallLanes(2.0) * b, b },
+                next, curr, nullptr, 1, N - 1);
+        }
+        const WallLanes bc = WallLanes(theta) * r * Tsur;
+        (WallLanes::load(rhs) + bc).store(rhs);
+        (WallLanes::load(rhs + (n_int - 1) * L) + bc).store(rhs + (n_int - 1) * L);
+
+        for (std::size_t w = 0; w < L; ++w) {
+            rhs[w] *= inv_pivot[w];
+        }
+        for (std::size_t k = 1; k < n_int; ++k) {
+            for (std::size_t w = 0; w < L; ++w) {
+                rhs[k * L + w] = (rhs[k * L + w] - sub[w] * rhs[(k - 1) * L + w])
+                    * inv_pivot[k * L + w];
+            }
+        }
+        for (std::size_t k = n_int - 1; k-- > 0; ) {
+            for (std::size_t w = 0; w < L; ++w) {
+                rhs[k * L + w] -= c_prime[k * L + w] * rhs[(k + 1) * L + w];
+            }
+        }
+    }
+}
+
+EnsembleSimulation::EnsembleSimulation(const Grid1D& grid,
+    std::vector<WallParameters> walls,
+    const std::string& scheme_name,
+    double dt, double t_end)
+    : grid_(grid),
+    walls_(std::move(walls)),
+    scheme_name_(scheme_name),
+    dt_(dt),
+    t_end_(t_end)
+{
+    if (walls_.empty()) {
+        throw std::runtime_error("EnsembleSimulation: no walls given");
+    }
+    if (grid_.size() < 3) {
+        throw std::runtime_error("EnsembleSimulation: grid too small (N < 3)");
+    }
+    if (!grid_.uniform()) {
+        throw std::runtime_error("EnsembleSimulation: non-uniform grids are not supported");
+    }
+
+    if (!visit_method(scheme_name, [](auto) {})) {
+        throw std::runtime_error("EnsembleSimulation: unknown scheme '" + scheme_name + "'");
+    }
+
+    n_blocks_ = (walls_.size() + L - 1) / L;
+    T_.resize(n_blocks_ * grid_.size() * L);
+}
+
+void EnsembleSimulation::run()
+{
+    int n_steps = static_cast<int>(std::round(t_end_ / dt_));
+
+    visit_method(scheme_name_, [&](auto method) {
+        ThreadPool::shared().parallel_for(n_blocks_, [&](std::size_t block) {
+            run_block<decltype(method)>(block, n_steps);
+        });
+    });
+
+    // Same time accumulation as Simulation::run
+    t_ = 0.0;
+    for (int n = 0; n < n_steps; ++n) {
+        t_ += dt_;
+    }
+}
+
+template <class Method>
+void EnsembleSimulation::run_block(std::size_t block, int n_steps)
+{
+    const std::size_t N = grid_.size();
+    const double dx = grid_.dx();
+    const double dt = dt_;
+
+    // Per-lane parameters; padding lanes repeat the last wall
+    WallLanes r, Tin, Tsur;
+    for (std::size_t w = 0; w < L; ++w) {
+        std::size_t wall = std::min(block * L + w, walls_.size() - 1);
+        r.v[w] = walls_[wall].D * dt / (dx * dx);
+        Tin.v[w] = walls_[wall].Tin;
+        Tsur.v[w] = walls_[wall].Tsur;
+    }
+
+    // Block-local ring of three levels, row i of a level at [i * L]
+    std::vector<double> storage(3 * N * L);
+    double* prev = storage.data();
+    double* curr = prev + N * L;
+    double* next = curr + N * L;
+
+    // Initial condition at t = 0 (walls included, as in Simulation::run)
+    for (std::size_t i = 0; i < N; ++i) {
+        Tin.store(curr + i * L);
+        Tin.store(prev + i * L);
+    }
+
+    // Theta methods: lane-wise Thomas factorization of the constant,
+    // symmetric (super == sub) matrix tridiag(-theta r, 1 + 2 theta r, -theta r)
+    const std::size_t n_int = N - 2;
+    std::array<double, L> sub{};
+    std::vector<double> c_prime, inv_pivot;
+    if constexpr (is_theta_method<Method>::value) {
+        std::array<double, L> diag{};
+        for (std::size_t w = 0; w < L; ++w) {
+            const double a = Method::theta * r.v[w];
+            sub[w] = -a;
+            diag[w] = 1.0 + 2.0 * a;
+        }
+
+        c_prime.resize(n_int * L);
+        inv_pivot.resize(n_int * L);
+        for (std::size_t w = 0; w < L; ++w) {
+            inv_pivot[w] = 1.0 / diag[w];
+            c_prime[w] = sub[w] * inv_pivot[w];
+        }
+        for (std::size_t k = 1; k < n_int; ++k) {
+            for (std::size_t w = 0; w < L; ++w) {
+                double beta = diag[w] - sub[w] * c_prime[(k - 1) * L + w];
+                inv_pivot[k * L + w] = 1.0 / beta;
+                c_prime[k * L + w] = sub[w] * inv_pivot[k * L + w];
+            }
+        }
+        for (std::size_t w = 0; w < L; ++w) {
+            c_prime[(n_int - 1) * L + w] = 0.0;
+        }
+    }
+
+    for (int n = 0; n < n_steps; ++n) {
+        if constexpr (is_theta_method<Method>::value) {
+            theta_step<Method>(next, curr, N, r, Tsur, sub, c_prime.data(), inv_pivot.data());
+        }
+        else {
+            explicit_step<Method>(next, curr, prev, N, r, Tsur, n == 0);
+        }
+
+        // n-1 <- n, n <- n+1
+        double* recycled = prev;
+        prev = curr;
+        curr = next;
+        next = recycled;
+    }
+
+    std::copy(curr, curr + N * L, T_.begin() + block * N * L);
+}
+
+std::size_t EnsembleSimulation::n_walls() const {
+    return walls_.size();
+}
+
+double EnsembleSimulation::time() const {
+    return t_;
+}
+
+void EnsembleSimulation::solution(std::size_t wall, std::vector<double>& T) const
+{
+    if (wall >= walls_.size()) {
+        throw std::runtime_error("EnsembleSimulation::solution: wall index out of range");
+    }
+
+    const std::size_t N = grid_.size();
+    const double* base = T_.data() + (wall / L) * N * L + wall % L;
+
+    T.resize(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        T[i] = base[i * L];
+    }
+}
+
+void EnsembleSimulation::store_result(std::size_t wall,
+    const std::string& scheme_name,
+    OutputManager& out) const
+{
+    std::vector<double> T_num;
+    solution(wall, T_num);
+
+    const WallParameters& p = walls_[wall];
+    HeatProblem problem(grid_, p.D, p.Tin, p.Tsur);
+
+    std::vector<double> T_exact;
+    AnalyticalSolution(problem).evaluate(grid_, t_, T_exact);
+
+    out.store_scheme_result(scheme_name, grid_, T_num, T_exact);
+}
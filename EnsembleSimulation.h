@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Grid1D.h"
+#include "OutputManager.h"
+
+// Physical parameters of one wall of an ensemble
+struct WallParameters {
+    double D;
+    double Tin;
+    double Tsur;
+};
+
+// Advances many independent walls that share one grid, one scheme and one dt.
+// The scheme is any method of SchemeMethods.h, run from its descriptor.
+//
+// Walls are stored interleaved in blocks of `lanes` walls (AoSoA): value i of
+// wall w lives at [block][i][lane], so every stencil update and every
+// Thomas sweep runs across the lanes of a block and vectorizes over walls
+// rather than along x. Blocks are independent and are advanced in parallel,
+// each one through all its time steps while its levels are cache resident.
+// Per wall, the results are the same as those of Simulation::run.
+// Uniform grids only.
+class EnsembleSimulation {
+public:
+    static constexpr std::size_t lanes = 8;
+
+    EnsembleSimulation(const Grid1D& grid,
+        std::vector<WallParameters> walls,
+        const std::string& scheme_name,
+        double dt, double t_end);
+
+    void run();
+
+    std::size_t n_walls() const;
+    double time() const;  // time reached by run()
+
+    // Final profile of one wall
+    void solution(std::size_t wall, std::vector<double>& T) const;
+
+    // Same as Simulation::run does for a single wall
+    void store_result(std::size_t wall,
+        const std::string& scheme_name,
+        OutputManager& out) const;
+
+private:
+    template <class Method>
+    void run_block(std::size_t block, int n_steps);
+
+    const Grid1D& grid_;
+    std::vector<WallParameters> walls_;
+    std::string scheme_name_;  // a method of SchemeMethods.h
+    double dt_;
+    double t_end_;
+    double t_ = 0.0;
+    std::size_t n_blocks_;
+    std::vector<double> T_;  // final level of all blocks, [block][i][lane]
+};
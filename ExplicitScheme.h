@@ -0,0 +1,300 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "SchemeBase.h"
+#include "DiffusionCoefficients.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "StencilSweep.h"
+#include "Stencils.h"
+
+// How a three-level method takes its first step, while level n-1 does not
+// exist yet: with the two-level Method::start_up_stencil(r)
+enum class StartUp {
+    None,        // two-level method
+    AtTimeZero,  // whenever a step starts at t = 0
+    FirstStep    // on the scheme's first step (kept in checkpoints), with
+                 // Tsur as the outer neighbour of the wall-adjacent nodes
+};
+
+// Explicit scheme generated from a method descriptor:
+//
+//     // Stencils.h stencils in the type of r = D dt / dx^2 (double here;
+//     // other engines pass float, long double or a pack of walls)
+//     template <class Real> static ... stencil(Real r);
+//     static constexpr StartUp start_up = ...;
+//     template <class Real> static ... start_up_stencil(Real r);  // unless StartUp::None
+//
+//     // Variable coefficients, with kl, kr the DiffusionCoefficients
+//     // weights of the node
+//     static double update(double kl, double kr, double left,
+//         double centre, double right, double prev);
+//
+// A homogeneous wall on a uniform grid runs the generated sweep of the
+// stencil (reduced strip by strip when observed, temporally blocked by
+// step_blocked()); otherwise update() is applied node by node, with the
+// start-up step T + kl (T_{i-1} - T) + kr (T_{i+1} - T).
+//
+// Each method explicitly instantiates the scheme and its SchemeBase in its
+// own source file (see RichardsonScheme.cpp).
+template <class Method>
+class ExplicitScheme : public SchemeBase<ExplicitScheme<Method>> {
+public:
+    explicit ExplicitScheme(const HeatProblem& problem);
+
+    bool step_blocked(std::vector<double>& T_curr,
+        std::vector<double>& T_prev,
+        double t, double dt, std::size_t n_steps,
+        const TemporalBlocking& blocking) override;
+
+    // The start-up flag of StartUp::FirstStep methods
+    void save_state(std::vector<unsigned char>& state) const override;
+    void load_state(const std::vector<unsigned char>& state) override;
+    void reset_state() override;
+
+private:
+    friend class SchemeBase<ExplicitScheme>;
+    using Stencil = decltype(Method::stencil(0.0));
+
+    struct Coefficients {
+        std::size_t N;
+        double r;
+        double Tsur;
+        Stencil stencil;
+        const double* left;   // DiffusionCoefficients, variable
+        const double* right;  // coefficients only (nullptr otherwise)
+    };
+
+    Coefficients coefficients(double dt);
+
+    void kernel(const Coefficients& coef,
+        const std::vector<double>& T_curr,
+        const std::vector<double>& T_prev,
+        std::vector<double>& T_next,
+        double t);
+
+    // kernel() with the new level reduced strip by strip as it is written
+    void observed_kernel(const Coefficients& coef,
+        const std::vector<double>& T_curr,
+        const std::vector<double>& T_prev,
+        std::vector<double>& T_next,
+        double t, StepStatistics& stats);
+
+    // The step starting at t is the start-up step
+    bool starting(double t) const;
+
+    // Start-up step on a homogeneous wall and uniform grid
+    void start_up_step(const Coefficients& coef,
+        const std::vector<double>& T_curr, std::vector<double>& T_next);
+
+    bool first_step_ = true;  // StartUp::FirstStep only
+    DiffusionCoefficients weights_;  // variable-coefficient path
+};
+
+template <class Method>
+ExplicitScheme<Method>::ExplicitScheme(const HeatProblem& problem)
+    : SchemeBase<ExplicitScheme>(problem) {
+}
+
+template <class Method>
+typename ExplicitScheme<Method>::Coefficients ExplicitScheme<Method>::coefficients(double dt)
+{
+    const HeatProblem& problem = this->problem_;
+    const Grid1D& grid = problem.grid();
+    if (!problem.constant_coefficients()) {
+        weights_.update(problem, dt);
+        return { grid.size(), 0.0, problem.Tsur(), Method::stencil(0.0),
+            weights_.left(), weights_.right() };
+    }
+
+    double dx = grid.dx();
+    double r = problem.diffusivity() * dt / (dx * dx);
+    return { grid.size(), r, problem.Tsur(), Method::stencil(r), nullptr, nullptr };
+}
+
+template <class Method>
+bool ExplicitScheme<Method>::starting(double t) const
+{
+    if constexpr (Method::start_up == StartUp::AtTimeZero) {
+        return t == 0.0;
+    }
+    else if constexpr (Method::start_up == StartUp::FirstStep) {
+        return first_step_;
+    }
+    else {
+        (void)t;
+        return false;
+    }
+}
+
+template <class Method>
+void ExplicitScheme<Method>::start_up_step(const Coefficients& coef,
+    const std::vector<double>& T_curr, std::vector<double>& T_next)
+{
+    if constexpr (Method::start_up != StartUp::None) {
+        const std::size_t N = coef.N;
+        const double Tsur = coef.Tsur;
+        const auto stencil = Method::start_up_stencil(coef.r);
+        const auto sweep = stencil_sweep<decltype(stencil)>();
+
+        if constexpr (Method::start_up == StartUp::FirstStep) {
+            // The known level still holds the initial condition at the
+            // walls, but the boundary conditions are enforced on it
+            // (Hoffmann), so the two wall-adjacent nodes see Tsur as their
+            // outer neighbour.
+            if (N > 4) {
+                sweep(stencil, T_next.data() + 2, T_curr.data() + 2, nullptr, N - 4);
+            }
+            T_next[1] = stencil(Tsur, T_curr[1], N > 3 ? T_curr[2] : Tsur, T_curr[1]);
+            T_next[N - 2] = stencil(N > 3 ? T_curr[N - 3] : Tsur, T_curr[N - 2], Tsur, T_curr[N - 2]);
+        }
+        else {
+            sweep(stencil, T_next.data() + 1, T_curr.data() + 1, nullptr, N - 2);
+        }
+    }
+    else {
+        (void)coef; (void)T_curr; (void)T_next;
+    }
+}
+
+template <class Method>
+inline void ExplicitScheme<Method>::kernel(const Coefficients& coef,
+    const std::vector<double>& T_curr,
+    const std::vector<double>& T_prev,
+    std::vector<double>& T_next,
+    double t)
+{
+    const std::size_t N = coef.N;
+    const double Tsur = coef.Tsur;
+
+    if (N < 3) return;  // nothing to do on tiny grid
+
+    T_next[0] = Tsur;
+    T_next[N - 1] = Tsur;
+
+    const bool start_up = starting(t);
+    first_step_ = false;
+
+    // Non-uniform grid or composite wall: node-wise weights
+    if (coef.left) {
+        const double* kl = coef.left;
+        const double* kr = coef.right;
+        if (start_up) {
+            const bool walls = (Method::start_up == StartUp::FirstStep);
+            for (std::size_t i = 1; i + 1 < N; ++i) {
+                double left = (walls && i == 1) ? Tsur : T_curr[i - 1];
+                double right = (walls && i + 2 == N) ? Tsur : T_curr[i + 1];
+                T_next[i] = T_curr[i] + (kl[i] * (left - T_curr[i])
+                    + kr[i] * (right - T_curr[i]));
+            }
+            return;
+        }
+        for (std::size_t i = 1; i + 1 < N; ++i) {
+            T_next[i] = Method::update(kl[i], kr[i],
+                T_curr[i - 1], T_curr[i], T_curr[i + 1], T_prev[i]);
+        }
+        return;
+    }
+
+    if (start_up) {
+        start_up_step(coef, T_curr, T_next);
+        return;
+    }
+    stencil_sweep<Stencil>()(coef.stencil, T_next.data() + 1, T_curr.data() + 1,
+        T_prev.data() + 1, N - 2);
+}
+
+template <class Method>
+inline void ExplicitScheme<Method>::observed_kernel(const Coefficients& coef,
+    const std::vector<double>& T_curr,
+    const std::vector<double>& T_prev,
+    std::vector<double>& T_next,
+    double t, StepStatistics& stats)
+{
+    // Variable coefficients and the start-up step with Tsur neighbours:
+    // reduce after the kernel
+    const bool start_up = starting(t);
+    if (coef.left || coef.N < 3 || (start_up && Method::start_up == StartUp::FirstStep)) {
+        SchemeBase<ExplicitScheme>::observed_kernel(coef, T_curr, T_prev, T_next, t, stats);
+        return;
+    }
+
+    // Same sweeps as kernel(), strip by strip
+    const std::size_t N = coef.N;
+    T_next[0] = coef.Tsur;
+    T_next[N - 1] = coef.Tsur;
+
+    double* out = T_next.data() + 1;
+    const double* curr = T_curr.data() + 1;
+    const double* prev = T_prev.data() + 1;
+    if constexpr (Method::start_up == StartUp::AtTimeZero) {
+        if (start_up) {
+            const auto stencil = Method::start_up_stencil(coef.r);
+            const auto sweep = stencil_sweep<decltype(stencil)>();
+            write_and_reduce(out, curr, N - 2, stats,
+                [&](std::size_t i, std::size_t n) {
+                    sweep(stencil, out + i, curr + i, nullptr, n);
+                });
+            return;
+        }
+    }
+
+    const auto sweep = stencil_sweep<Stencil>();
+    write_and_reduce(out, curr, N - 2, stats,
+        [&](std::size_t i, std::size_t n) {
+            sweep(coef.stencil, out + i, curr + i, prev + i, n);
+        });
+}
+
+template <class Method>
+bool ExplicitScheme<Method>::step_blocked(std::vector<double>& T_curr,
+    std::vector<double>& T_prev,
+    double t, double dt, std::size_t n_steps,
+    const TemporalBlocking& blocking)
+{
+    // The start-up step and variable coefficients are not blocked
+    if (starting(t) || !this->problem_.constant_coefficients()) {
+        return false;
+    }
+
+    const Stencil stencil = coefficients(dt).stencil;
+    const auto sweep = stencil_sweep<Stencil>();
+
+    advance_tiled(T_curr, T_prev, n_steps, blocking,
+        [sweep, &stencil](double* next, const double* curr, const double* prev, std::size_t n) {
+            sweep(stencil, next, curr, prev, n);
+        });
+    return true;
+}
+
+template <class Method>
+void ExplicitScheme<Method>::save_state(std::vector<unsigned char>& state) const
+{
+    if constexpr (Method::start_up == StartUp::FirstStep) {
+        state.assign(1, first_step_ ? 1 : 0);
+    }
+    else {
+        TimeScheme::save_state(state);
+    }
+}
+
+template <class Method>
+void ExplicitScheme<Method>::load_state(const std::vector<unsigned char>& state)
+{
+    if constexpr (Method::start_up == StartUp::FirstStep) {
+        if (state.size() != 1) {
+            throw std::runtime_error("ExplicitScheme::load_state: bad state");
+        }
+        first_step_ = (state[0] != 0);
+    }
+    else {
+        TimeScheme::load_state(state);
+    }
+}
+
+template <class Method>
+void ExplicitScheme<Method>::reset_state()
+{
+    first_step_ = true;
+}
@@ -0,0 +1,4 @@
+#include "FtcsScheme.h"
+
+template class ExplicitScheme<FtcsMethod>;
+template class SchemeBase<FtcsScheme>;
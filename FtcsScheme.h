@@ -0,0 +1,25 @@
+#pragma once
+#include "ExplicitScheme.h"
+
+// Forward Time, Centred Space: T^{n+1} = r T_{i-1} + (1 - 2r) T_i + r T_{i+1}.
+// Two-level; stable for r <= 1/2.
+struct FtcsMethod {
+    template <class Real>
+    static BasicThreePointStencil<Real> stencil(Real r)
+    {
+        return { r, Real(1.0) - Real(2.0) * r, r };
+    }
+
+    static constexpr StartUp start_up = StartUp::None;
+
+    static double update(double kl, double kr, double left, double centre,
+        double right, double /*prev*/)
+    {
+        return centre + (kl * (left - centre) + kr * (right - centre));
+    }
+};
+
+using FtcsScheme = ExplicitScheme<FtcsMethod>;
+
+extern template class ExplicitScheme<FtcsMethod>;
+extern template class SchemeBase<FtcsScheme>;
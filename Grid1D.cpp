@@ -1,21 +1,74 @@
 #include "Grid1D.h"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <utility>
 
 Grid1D::Grid1D(double length, double dx)
-    : L_(length), dx_(dx)
+    : L_(length), dx_(dx), uniform_(true), n_(0)
 {
     if (L_ <= 0 || dx_ <= 0)
         throw std::runtime_error("Grid1D: length and dx must be positive");
 
-    std::size_t N = static_cast<std::size_t>(L_ / dx_) + 1;
-    x_.resize(N);
+    n_ = static_cast<std::size_t>(L_ / dx_) + 1;
+}
+
+Grid1D::Grid1D(std::vector<double> x)
+    : L_(0.0), dx_(0.0), uniform_(false), n_(x.size()), x_(std::move(x))
+{
+    if (x_.size() < 2 || x_.front() != 0.0)
+        throw std::runtime_error("Grid1D: need at least two nodes starting at x = 0");
+
+    dx_ = x_[1] - x_[0];
+    for (std::size_t i = 1; i < x_.size(); ++i) {
+        double h = x_[i] - x_[i - 1];
+        if (!(h > 0))
+            throw std::runtime_error("Grid1D: coordinates must be strictly increasing");
+        dx_ = std::min(dx_, h);
+    }
+    L_ = x_.back();
+
+    compute_weights();
+}
+
+Grid1D Grid1D::graded(double length, std::size_t n_nodes, double stretching)
+{
+    if (length <= 0 || n_nodes < 2 || stretching <= 0)
+        throw std::runtime_error("Grid1D::graded: need length > 0, n_nodes >= 2, stretching > 0");
+
+    std::vector<double> x(n_nodes);
+    const double scale = std::tanh(stretching);
+    for (std::size_t i = 0; i < n_nodes; ++i) {
+        double xi = 2.0 * static_cast<double>(i) / static_cast<double>(n_nodes - 1) - 1.0;
+        x[i] = 0.5 * length * (1.0 + std::tanh(stretching * xi) / scale);
+    }
+    // Pin the walls against rounding
+    x.front() = 0.0;
+    x.back() = length;
+
+    return Grid1D(std::move(x));
+}
+
+void Grid1D::compute_weights()
+{
+    const std::size_t N = x_.size();
+    lap_left_.assign(N, 0.0);
+    lap_right_.assign(N, 0.0);
 
-    for (std::size_t i = 0; i < N; ++i)
-        x_[i] = i * dx_;
+    for (std::size_t i = 1; i + 1 < N; ++i) {
+        double h_l = x_[i] - x_[i - 1];
+        double h_r = x_[i + 1] - x_[i];
+        lap_left_[i] = 2.0 / (h_l * (h_l + h_r));
+        lap_right_[i] = 2.0 / (h_r * (h_l + h_r));
+    }
 }
 
 std::size_t Grid1D::size() const {
-    return x_.size();
+    return n_;
+}
+
+bool Grid1D::uniform() const {
+    return uniform_;
 }
 
 double Grid1D::dx() const {
@@ -27,9 +80,27 @@ double Grid1D::length() const {
 }
 
 double Grid1D::x(std::size_t i) const {
-    return x_.at(i);
+    if (!uniform_)
+        return x_.at(i);
+    if (i >= n_)
+        throw std::out_of_range("Grid1D::x: node index out of range");
+    return i * dx_;
+}
+
+std::vector<double> Grid1D::coords() const {
+    if (!uniform_)
+        return x_;
+
+    std::vector<double> x(n_);
+    for (std::size_t i = 0; i < n_; ++i)
+        x[i] = i * dx_;
+    return x;
+}
+
+const std::vector<double>& Grid1D::laplacian_left() const {
+    return lap_left_;
 }
 
-const std::vector<double>& Grid1D::coords() const {
-    return x_;
+const std::vector<double>& Grid1D::laplacian_right() const {
+    return lap_right_;
 }
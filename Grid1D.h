@@ -4,17 +4,43 @@
 
 class Grid1D {
 public:
+    // Uniform grid x_i = i * dx (the last node lies on x = length only if
+    // dx divides it). Stores no per-node data: coordinates are computed on
+    // the fly, so the grid may have billions of nodes.
     Grid1D(double length, double dx);
 
+    // Non-uniform grid through the given nodes: x[0] = 0, strictly
+    // increasing, length = x.back()
+    explicit Grid1D(std::vector<double> x);
+
+    // n_nodes nodes on [0, length] clustered towards both walls:
+    // x_i = L/2 * (1 + tanh(s (2 i / (n - 1) - 1)) / tanh(s)).
+    // stretching s > 0; the spacing at the walls shrinks as s grows.
+    static Grid1D graded(double length, std::size_t n_nodes, double stretching);
+
     std::size_t size() const;
-    double dx() const;
+    bool uniform() const;
+    double dx() const;  // spacing; the smallest one if non-uniform
     double length() const;
     double x(std::size_t i) const;
-    const std::vector<double>& coords() const;
+    std::vector<double> coords() const;  // all x_i
+
+    // Weights of the three-point second derivative at interior node i,
+    //     T''(x_i) ~ left[i] (T[i-1] - T[i]) + right[i] (T[i+1] - T[i]),
+    // with left = 2 / (h_l (h_l + h_r)), right = 2 / (h_r (h_l + h_r)) for
+    // the spacings h_l, h_r on either side (1 / dx^2 on a uniform grid).
+    // Entries 0 and size() - 1 are zero. Empty on a uniform grid.
+    const std::vector<double>& laplacian_left() const;
+    const std::vector<double>& laplacian_right() const;
 
 private:
+    void compute_weights();
+
     double L_;
     double dx_;
-    std::vector<double> x_;
+    bool uniform_;
+    std::size_t n_;
+    std::vector<double> x_;         // non-uniform grid only
+    std::vector<double> lap_left_;
+    std::vector<double> lap_right_;
 };
-
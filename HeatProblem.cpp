@@ -1,13 +1,102 @@
 #include "HeatProblem.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 HeatProblem::HeatProblem(const Grid1D& grid, double D, double Tin, double Tsur)
-    : grid_(grid), D_(D), Tin_(Tin), Tsur_(Tsur) {
+    : grid_(grid), layers_{ { grid.length(), D } }, homogeneous_(true),
+    D_(D), Tin_(Tin), Tsur_(Tsur) {
+}
+
+HeatProblem::HeatProblem(const Grid1D& grid, std::vector<Layer> layers, double Tin, double Tsur)
+    : grid_(grid), layers_(std::move(layers)), homogeneous_(true),
+    D_(0.0), Tin_(Tin), Tsur_(Tsur) {
+    if (layers_.empty())
+        throw std::runtime_error("HeatProblem: need at least one layer");
+
+    double total = 0.0;
+    for (const Layer& layer : layers_) {
+        if (!(layer.thickness > 0) || !(layer.D > 0))
+            throw std::runtime_error("HeatProblem: layer thickness and D must be positive");
+        total += layer.thickness;
+        homogeneous_ = homogeneous_ && layer.D == layers_.front().D;
+    }
+    if (std::abs(total - grid.length()) > 1e-9 * grid.length())
+        throw std::runtime_error("HeatProblem: layer thicknesses must add up to the wall length");
+
+    if (homogeneous_)
+        D_ = layers_.front().D;
 }
 
 double HeatProblem::diffusivity() const {
+    if (!homogeneous_)
+        throw std::runtime_error("HeatProblem::diffusivity: a composite wall has no single diffusivity");
     return D_;
 }
 
+double HeatProblem::diffusivity(double x) const {
+    double end = 0.0;
+    for (std::size_t k = 0; k + 1 < layers_.size(); ++k) {
+        end += layers_[k].thickness;
+        if (x < end)
+            return layers_[k].D;
+    }
+    return layers_.back().D;
+}
+
+bool HeatProblem::homogeneous() const {
+    return homogeneous_;
+}
+
+bool HeatProblem::constant_coefficients() const {
+    return homogeneous_ && grid_.uniform();
+}
+
+void HeatProblem::face_diffusivities(std::vector<double>& D_face) const {
+    const std::size_t N = grid_.size();
+    D_face.assign(N > 0 ? N - 1 : 0, D_);
+    if (homogeneous_)
+        return;
+
+    // Layer k covers [start, end); the last one extends to infinity so
+    // that rounding in the thicknesses cannot leave a gap at x = L
+    std::size_t k = 0;
+    double start = 0.0;
+    double end = layers_.size() > 1 ? layers_[0].thickness : std::numeric_limits<double>::infinity();
+    auto next_layer = [&]() {
+        ++k;
+        start = end;
+        end = (k + 1 < layers_.size()) ? end + layers_[k].thickness
+            : std::numeric_limits<double>::infinity();
+    };
+
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+        const double a = grid_.x(i);
+        const double b = grid_.x(i + 1);
+        while (end <= a)
+            next_layer();
+
+        if (b <= end) {
+            D_face[i] = layers_[k].D;
+            continue;
+        }
+
+        // Resistances (length / D) of the pieces in series
+        double resistance = (end - a) / layers_[k].D;
+        while (end < b) {
+            next_layer();
+            resistance += (std::min(b, end) - start) / layers_[k].D;
+        }
+        D_face[i] = (b - a) / resistance;
+    }
+}
+
+const std::vector<Layer>& HeatProblem::layers() const {
+    return layers_;
+}
+
 double HeatProblem::Tin() const {
     return Tin_;
 }
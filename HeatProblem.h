@@ -2,11 +2,39 @@
 #include <vector>
 #include "Grid1D.h"
 
+// One material of a composite wall
+struct Layer {
+    double thickness;  // cm
+    double D;          // cm^2/hr
+};
+
 class HeatProblem {
 public:
     HeatProblem(const Grid1D& grid, double D, double Tin, double Tsur);
 
+    // Composite wall: layers from x = 0 outwards, their thicknesses adding
+    // up to the grid length
+    HeatProblem(const Grid1D& grid, std::vector<Layer> layers, double Tin, double Tsur);
+
+    // The diffusivity of a homogeneous wall; throws for a composite one
     double diffusivity() const;
+
+    // D(x); at an interface, the layer on the right
+    double diffusivity(double x) const;
+
+    // All layers have the same D
+    bool homogeneous() const;
+
+    // Homogeneous wall on a uniform grid: the schemes take their fast path
+    // with a single r = D dt / dx^2
+    bool constant_coefficients() const;
+
+    // D_face[i] = harmonic mean of D(x) over [x_i, x_i+1] (N - 1 values):
+    // the layers crossed by a segment act as conductances in series
+    void face_diffusivities(std::vector<double>& D_face) const;
+
+    const std::vector<Layer>& layers() const;
+
     double Tin() const;
     double Tsur() const;
     const Grid1D& grid() const;
@@ -16,7 +44,9 @@ public:
 
 private:
     const Grid1D& grid_;
-    double D_;
+    std::vector<Layer> layers_;
+    bool homogeneous_;
+    double D_;          // homogeneous wall only
     double Tin_;
     double Tsur_;
 };
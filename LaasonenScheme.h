@@ -1,17 +1,12 @@
 #pragma once
-#include <vector>
-#include "TimeScheme.h"
+#include "ThetaScheme.h"
 
-class LaasonenScheme : public TimeScheme {
-public:
-    explicit LaasonenScheme(const HeatProblem& problem);
+// Laasonen (fully implicit, backward Euler in time)
+struct LaasonenMethod {
+    static constexpr double theta = 1.0;
+};
 
-    void step(std::vector<double>& T_curr,
-        std::vector<double>& T_prev,
-        double t, double dt) override;
-
-private:
-    // coefficients (could be resized each dt, or recomputed on the fly)
-    std::vector<double> a_, b_, c_; // tri-diagonal
-}; 
+using LaasonenScheme = ThetaScheme<LaasonenMethod>;
 
+extern template class ThetaScheme<LaasonenMethod>;
+extern template class SchemeBase<LaasonenScheme>;
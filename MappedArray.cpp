@@ -0,0 +1,89 @@
+#include "MappedArray.h"
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+MappedArray::MappedArray(const std::string& filename, std::size_t n)
+    : filename_(filename), n_(n)
+{
+    if (n_ == 0) {
+        throw std::runtime_error("MappedArray: empty array");
+    }
+
+    fd_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot create mapped file: " + filename_);
+    }
+    // Sparse file: blocks are allocated as the pages are written
+    const std::size_t bytes = n_ * sizeof(double);
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+        ::close(fd_);
+        ::unlink(filename_.c_str());
+        throw std::runtime_error("Cannot size mapped file: " + filename_);
+    }
+
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd_);
+        ::unlink(filename_.c_str());
+        throw std::runtime_error("Cannot map file: " + filename_);
+    }
+    data_ = static_cast<double*>(p);
+}
+
+MappedArray::~MappedArray()
+{
+    ::munmap(data_, n_ * sizeof(double));
+    ::close(fd_);
+    ::unlink(filename_.c_str());
+}
+
+bool MappedArray::pages(std::size_t first, std::size_t count,
+    char*& begin, std::size_t& bytes) const
+{
+    if (first >= n_ || count == 0) {
+        return false;
+    }
+    if (count > n_ - first) {
+        count = n_ - first;
+    }
+
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    char* base = reinterpret_cast<char*>(data_);
+    const std::size_t lo = first * sizeof(double) / page * page;
+    const std::size_t hi = (first + count) * sizeof(double);
+    begin = base + lo;
+    bytes = hi - lo;
+    return true;
+}
+
+void MappedArray::advise_sequential()
+{
+    ::madvise(data_, n_ * sizeof(double), MADV_SEQUENTIAL);
+}
+
+void MappedArray::prefetch(std::size_t first, std::size_t count)
+{
+    char* begin;
+    std::size_t bytes;
+    if (pages(first, count, begin, bytes)) {
+        ::madvise(begin, bytes, MADV_WILLNEED);
+    }
+}
+
+void MappedArray::write_back(std::size_t first, std::size_t count)
+{
+    char* begin;
+    std::size_t bytes;
+    if (pages(first, count, begin, bytes)) {
+#ifdef __linux__
+        // msync(MS_ASYNC) does not start any I/O on Linux
+        const off_t offset = begin - reinterpret_cast<char*>(data_);
+        ::sync_file_range(fd_, offset, static_cast<off_t>(bytes), SYNC_FILE_RANGE_WRITE);
+#else
+        ::msync(begin, bytes, MS_ASYNC);
+#endif
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Array of doubles in a memory-mapped file (POSIX), for data larger than
+// RAM: the kernel pages it in and out of the page cache. The file is
+// created (or truncated) with n zeros and removed again by the destructor.
+class MappedArray {
+public:
+    MappedArray(const std::string& filename, std::size_t n);
+    ~MappedArray();
+
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    double* data() { return data_; }
+    const double* data() const { return data_; }
+    std::size_t size() const { return n_; }
+
+    // Access hints; ranges in elements, clipped to the array.
+    // Sequential access: larger read-ahead, pages behind are dropped early
+    void advise_sequential();
+    // Start reading [first, first + count) in the background
+    void prefetch(std::size_t first, std::size_t count);
+    // Start writing the dirty pages of [first, first + count) back to the
+    // file without waiting, so that write-back keeps pace with the march
+    void write_back(std::size_t first, std::size_t count);
+
+private:
+    // Page-aligned byte range covering [first, first + count)
+    bool pages(std::size_t first, std::size_t count, char*& begin, std::size_t& bytes) const;
+
+    std::string filename_;
+    std::size_t n_;
+    double* data_ = nullptr;
+    int fd_ = -1;
+};
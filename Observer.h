@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "StepStatistics.h"
+
+class HeatProblem;
+
+// State seen by an Observer after a step
+struct Observation {
+    std::size_t step;               // steps taken since t = 0
+    double t;
+    const std::vector<double>& T;   // the new level
+    const StepStatistics& stats;    // reductions of the new level
+};
+
+// In-situ diagnostic hooked into Simulation's time loop (see
+// ObserverPipeline). observe() runs inside the loop: it should read the
+// profile at a few nodes or use the fused statistics, not sweep over it.
+class Observer {
+public:
+    virtual ~Observer() = default;
+
+    // Before the first step of a run (or of a resumed run)
+    virtual void start(const HeatProblem& /*problem*/, std::size_t /*step*/,
+        double /*t*/, const std::vector<double>& /*T*/) {}
+
+    virtual void observe(const Observation& observation) = 0;
+
+    // Ends the run early once true (checked after observe())
+    virtual bool converged() const { return false; }
+};
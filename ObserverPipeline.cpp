@@ -0,0 +1,58 @@
+#include "ObserverPipeline.h"
+#include <stdexcept>
+
+void ObserverPipeline::add(Observer& observer, std::size_t every)
+{
+    if (every == 0) {
+        throw std::runtime_error("ObserverPipeline::add: interval must be positive");
+    }
+    entries_.push_back({ &observer, every });
+}
+
+bool ObserverPipeline::empty() const
+{
+    return entries_.empty();
+}
+
+void ObserverPipeline::start(const HeatProblem& problem, std::size_t step,
+    double t, const std::vector<double>& T)
+{
+    first_step_ = step;
+    step_ = step;
+    last_ = StepStatistics();
+    stopped_ = false;
+    for (const Entry& e : entries_) {
+        e.observer->start(problem, step, t, T);
+    }
+}
+
+bool ObserverPipeline::after_step(double t, const std::vector<double>& T,
+    const StepStatistics& stats)
+{
+    ++step_;
+    last_ = stats;
+    for (const Entry& e : entries_) {
+        if (step_ % e.every == 0) {
+            e.observer->observe({ step_, t, T, stats });
+            stopped_ = stopped_ || e.observer->converged();
+        }
+    }
+    return !stopped_;
+}
+
+void ObserverPipeline::finish(double t, const std::vector<double>& T)
+{
+    if (step_ == first_step_) {
+        return;
+    }
+    for (const Entry& e : entries_) {
+        if (step_ % e.every != 0) {
+            e.observer->observe({ step_, t, T, last_ });
+        }
+    }
+}
+
+bool ObserverPipeline::stopped() const
+{
+    return stopped_;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Observer.h"
+
+// Observers of a run, each called every `every` steps. The schemes hand
+// the pipeline every new level together with its StepStatistics (see
+// TimeScheme::advance_observed); the pipeline counts the steps and stops
+// the march once an observer has converged.
+class ObserverPipeline {
+public:
+    // observer must outlive the runs
+    void add(Observer& observer, std::size_t every);
+
+    bool empty() const;
+
+    // Starts a run at step index `step` with profile T
+    void start(const HeatProblem& problem, std::size_t step, double t,
+        const std::vector<double>& T);
+
+    // After each step; returns false once the run should stop
+    bool after_step(double t, const std::vector<double>& T,
+        const StepStatistics& stats);
+
+    // Observes the last step in the observers that skipped it
+    void finish(double t, const std::vector<double>& T);
+
+    // True if an observer has converged in this run
+    bool stopped() const;
+
+private:
+    struct Entry {
+        Observer* observer;
+        std::size_t every;
+    };
+
+    std::vector<Entry> entries_;
+    std::size_t first_step_ = 0;
+    std::size_t step_ = 0;
+    StepStatistics last_;
+    bool stopped_ = false;
+};
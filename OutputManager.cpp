@@ -1,37 +1,170 @@
 ﻿#include "OutputManager.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
-#include <iomanip>
-#include <sstream>
 #include <stdexcept>
 #include <iostream>
+#include "Telemetry.h"
+
+namespace {
+    // Built-in schemes: CSV header and column order
+    struct KnownScheme {
+        const char* name;
+        const char* header;
+    };
+
+    constexpr KnownScheme known_schemes[] = {
+        { "DuFortFrankel", "T (K) DuFort_Frankel_Explicit_Scheme" },
+        { "Richardson",    "T (K) Richardson_Explicit_Scheme" },
+        { "Laasonen",      "T (K) Laasonen_Simple_Implicit_Scheme" },
+        { "CrankNicolson", "T (K) Crank_Nicholson_Implicit_Scheme" },
+        { "Spectral",      "T (K) Spectral_Sine_Transform" },
+    };
+
+    constexpr std::size_t n_known = sizeof(known_schemes) / sizeof(known_schemes[0]);
+
+    std::size_t known_rank(const std::string& name)
+    {
+        for (std::size_t k = 0; k < n_known; ++k) {
+            if (name == known_schemes[k].name) {
+                return k;
+            }
+        }
+        return n_known;
+    }
+
+    std::string column_header(const std::string& name)
+    {
+        std::size_t k = known_rank(name);
+        return (k < n_known) ? known_schemes[k].header : "T (K) " + name;
+    }
+
+    // Appends formatted rows to a large buffer that is written out in one
+    // call whenever it fills up
+    class CsvBuffer {
+    public:
+        explicit CsvBuffer(std::ofstream& file)
+            : file_(file), buffer_(capacity) {
+        }
+
+        ~CsvBuffer() { flush(); }
+
+        void text(const std::string& s)
+        {
+            if (s.size() > capacity - used_) {
+                flush();
+                file_.write(s.data(), static_cast<std::streamsize>(s.size()));
+                written_ += s.size();
+                return;
+            }
+            std::copy(s.begin(), s.end(), buffer_.data() + used_);
+            used_ += s.size();
+        }
+
+        void put(char c)
+        {
+            if (used_ == capacity) {
+                flush();
+            }
+            buffer_[used_++] = c;
+        }
+
+        // Same digits as std::fixed << std::setprecision(4)
+        void number(double v)
+        {
+            if (capacity - used_ < max_number_chars) {
+                flush();
+            }
+            char* first = buffer_.data() + used_;
+            auto result = std::to_chars(first, buffer_.data() + capacity,
+                v, std::chars_format::fixed, 4);
+            used_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+        }
+
+        void flush()
+        {
+            file_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+            written_ += used_;
+            used_ = 0;
+        }
+
+        std::uint64_t bytes_written() const { return written_ + used_; }
+
+    private:
+        static constexpr std::size_t capacity = std::size_t(1) << 20;
+
+        // Longest fixed-notation double: sign, 309 digits, point, 4 decimals
+        static constexpr std::size_t max_number_chars = 320;
+
+        std::ofstream& file_;
+        std::vector<char> buffer_;
+        std::size_t used_ = 0;
+        std::uint64_t written_ = 0;
+    };
+}
 
 OutputManager::OutputManager(const std::string& base_folder)
     : base_folder_(base_folder)
 {
-    // base_folder_ is ignored in this simple version.
-    // CSV will be written in the current working directory.
+}
+
+std::string OutputManager::csv_path() const
+{
+    std::filesystem::path folder = base_folder_.empty() ? "." : base_folder_;
+    return (folder / "1D_Heat_Equation_Solution.csv").string();
+}
+
+void OutputManager::check_sizes(const Grid1D& grid,
+    const std::vector<double>& T_num,
+    const std::vector<double>& T_exact) const
+{
+    std::size_t N = grid.size();
+    if (T_num.size() != N || (!T_exact.empty() && T_exact.size() != N)) {
+        throw std::runtime_error("OutputManager::store_scheme_result: size mismatch");
+    }
 }
 
 void OutputManager::store_scheme_result(const std::string& scheme_name,
     const Grid1D& grid,
     const std::vector<double>& T_num,
     const std::vector<double>& T_exact)
+{
+    check_sizes(grid, T_num, T_exact);
+    HEAT_SCOPED_TIMER(Output, 1, T_num.size(), 16 * T_num.size());
+
+    // Copy outside the lock
+    std::vector<double> column(T_num);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    store_column(scheme_name, grid, std::move(column), T_exact);
+}
+
+void OutputManager::store_scheme_result(const std::string& scheme_name,
+    const Grid1D& grid,
+    std::vector<double>&& T_num,
+    const std::vector<double>& T_exact)
+{
+    check_sizes(grid, T_num, T_exact);
+    HEAT_SCOPED_TIMER(Output, 1, T_num.size(), 0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    store_column(scheme_name, grid, std::move(T_num), T_exact);
+}
+
+void OutputManager::store_column(const std::string& scheme_name,
+    const Grid1D& grid,
+    std::vector<double>&& T_num,
+    const std::vector<double>& T_exact)
 {
     std::size_t N = grid.size();
-    if (T_num.size() != N || T_exact.size() != N) {
-        throw std::runtime_error("OutputManager::store_scheme_result: size mismatch");
-    }
 
-    // First time: initialize x, exact, and column vectors
+    // First time: initialize x and exact
     if (!initialized_) {
         x_m_.resize(N);
         exact_ = T_exact;
 
-        duFort_.assign(N, 0.0);
-        richardson_.assign(N, 0.0);
-        laasonen_.assign(N, 0.0);
-        crank_.assign(N, 0.0);
-
         // Our grid is in cm → convert to meters for the CSV header "x (m)"
         for (std::size_t i = 0; i < N; ++i) {
             x_m_[i] = grid.x(i) / 100.0; // cm → m
@@ -39,60 +172,79 @@ void OutputManager::store_scheme_result(const std::string& scheme_name,
 
         initialized_ = true;
     }
-
-    if (scheme_name == "DuFortFrankel") {
-        duFort_ = T_num;
-    }
-    else if (scheme_name == "Richardson") {
-        richardson_ = T_num;
-    }
-    else if (scheme_name == "Laasonen") {
-        laasonen_ = T_num;
+    else if (N != x_m_.size()) {
+        throw std::runtime_error("OutputManager::store_scheme_result: grid differs from earlier results");
     }
-    else if (scheme_name == "CrankNicolson") {
-        crank_ = T_num;
-    }
-    else {
-        std::cerr << "Warning: unknown scheme name '" << scheme_name
-            << "' in store_scheme_result\n";
+
+    for (Column& column : columns_) {
+        if (column.name == scheme_name) {
+            column.values = std::move(T_num);
+            return;
+        }
     }
+    columns_.push_back({ scheme_name, std::move(T_num) });
 }
 
 void OutputManager::write_combined_csv() const
 {
+    std::lock_guard<std::mutex> lock(mutex_);
+    HEAT_SCOPED_TIMER(Output, 1, x_m_.size(), 0);
+
     if (!initialized_) {
         throw std::runtime_error("OutputManager::write_combined_csv: no data stored");
     }
 
-    // Build filename in working directory
-    std::string filename = "1D_Heat_Equation_Solution.csv";
+    if (!base_folder_.empty()) {
+        std::filesystem::create_directories(base_folder_);
+    }
+    std::string filename = csv_path();
 
-    std::ofstream file(filename);
+    std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open output file: " + filename);
     }
 
-    // Header exactly like your example file
-    file << "x (m),"
-        << "T (K) Exact_Solution,"
-        << "T (K) DuFort_Frankel_Explicit_Scheme,"
-        << "T (K) Richardson_Explicit_Scheme,"
-        << "T (K) Laasonen_Simple_Implicit_Scheme,"
-        << "T (K) Crank_Nicholson_Implicit_Scheme\n";
-
-    file << std::fixed << std::setprecision(4);
-
-    std::size_t N = x_m_.size();
-    for (std::size_t i = 0; i < N; ++i) {
-        file << x_m_[i] << ","
-            << exact_[i] << ","
-            << duFort_[i] << ","
-            << richardson_[i] << ","
-            << laasonen_[i] << ","
-            << crank_[i] << "\n";
+    // Built-in schemes first, in their fixed order; others as stored
+    std::vector<const Column*> order;
+    for (const Column& column : columns_) {
+        order.push_back(&column);
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [](const Column* a, const Column* b) {
+            return known_rank(a->name) < known_rank(b->name);
+        });
+
+    {
+        CsvBuffer out(file);
+
+        out.text(exact_.empty() ? "x (m)" : "x (m),T (K) Exact_Solution");
+        for (const Column* column : order) {
+            out.text("," + column_header(column->name));
+        }
+        out.text("\n");
+
+        std::size_t N = x_m_.size();
+        for (std::size_t i = 0; i < N; ++i) {
+            out.number(x_m_[i]);
+            if (!exact_.empty()) {
+                out.put(',');
+                out.number(exact_[i]);
+            }
+            for (const Column* column : order) {
+                out.put(',');
+                out.number(column->values[i]);
+            }
+            out.put('\n');
+        }
+
+        out.flush();
+        HEAT_COUNT(Output, 0, 0, out.bytes_written());
     }
 
     file.close();
+    if (!file) {
+        throw std::runtime_error("Error writing output file: " + filename);
+    }
 
     std::cout << "Combined CSV written to: " << filename << "\n";
 }
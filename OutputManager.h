@@ -1,33 +1,63 @@
 #pragma once
+#include <mutex>
 #include <string>
 #include <vector>
 #include "Grid1D.h"
 
 class OutputManager {
 public:
+    // The CSV is written into base_folder (created if missing)
     explicit OutputManager(const std::string& base_folder);
 
-    // Store final-time result for a given scheme
+    // Store final-time result for a given scheme (thread-safe).
+    // Any scheme name is accepted; storing a name again replaces it.
+    // An empty T_exact means there is no closed-form solution (composite
+    // walls): the CSV then has no exact column.
     void store_scheme_result(const std::string& scheme_name,
         const Grid1D& grid,
         const std::vector<double>& T_num,
         const std::vector<double>& T_exact);
 
-    // Write single combined CSV with all schemes + exact solution
+    // Same, taking over T_num without copying it
+    void store_scheme_result(const std::string& scheme_name,
+        const Grid1D& grid,
+        std::vector<double>&& T_num,
+        const std::vector<double>& T_exact);
+
+    // Write single combined CSV with all schemes + exact solution.
+    // The built-in schemes come first in their usual order and with their
+    // usual headers, then any others in the order they were stored.
     void write_combined_csv() const;
 
+    // Path of the combined CSV
+    std::string csv_path() const;
+
 private:
+    struct Column {
+        std::string name;
+        std::vector<double> values;
+    };
+
+    void check_sizes(const Grid1D& grid,
+        const std::vector<double>& T_num,
+        const std::vector<double>& T_exact) const;
+
+    // Called with mutex_ held
+    void store_column(const std::string& scheme_name,
+        const Grid1D& grid,
+        std::vector<double>&& T_num,
+        const std::vector<double>& T_exact);
+
     std::string base_folder_;
 
-    // Common x and exact solution (same for all schemes)
+    // Common x and exact solution (same for all schemes; may be empty)
     std::vector<double> x_m_;     // x in meters
     std::vector<double> exact_;
 
-    // One column per scheme
-    std::vector<double> duFort_;
-    std::vector<double> richardson_;
-    std::vector<double> laasonen_;
-    std::vector<double> crank_;
+    // One column per scheme, in the order they were stored
+    std::vector<Column> columns_;
 
     bool initialized_ = false;
+
+    mutable std::mutex mutex_;  // schemes may report from several threads
 };
@@ -0,0 +1,290 @@
+#include "ParameterSweep.h"
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    // The exact solution stays within [Tin, Tsur]; a solution 100 times
+    // the range beyond it (or non-finite) comes from an unstable scheme
+    bool diverged(const SweepCase& c, const std::vector<double>& T, double max_error)
+    {
+        const double range = std::max(std::abs(c.Tsur - c.Tin), 1.0);
+        const double lo = std::min(c.Tin, c.Tsur) - 100.0 * range;
+        const double hi = std::max(c.Tin, c.Tsur) + 100.0 * range;
+        if (!std::isfinite(max_error)) {
+            return true;
+        }
+        for (double v : T) {
+            if (!(v >= lo && v <= hi)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SweepResult run_case(const SweepCase& c)
+    {
+        SweepResult result;
+        result.params = c;
+        result.n_nodes = c.n_nodes();
+        result.n_steps = c.n_steps();
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            Grid1D grid(c.length, c.dx);
+            HeatProblem problem(grid, c.D, c.Tin, c.Tsur);
+            Simulation sim(problem, make_scheme(c.scheme, problem), c.dt, c.t_end);
+
+            double t = sim.run_to_end();
+            const std::vector<double>& T = sim.solution();
+
+            std::vector<double> T_exact;
+            AnalyticalSolution(problem).evaluate(grid, t, T_exact);
+
+            double max_err = 0.0;
+            double sum_sq = 0.0;
+            for (std::size_t i = 0; i < grid.size(); ++i) {
+                double e = std::abs(T[i] - T_exact[i]);
+                max_err = std::max(max_err, e);
+                sum_sq += e * e;
+            }
+
+            result.max_error = max_err;
+            result.rms_error = std::sqrt(sum_sq / grid.size());
+            result.diverged = diverged(c, T, max_err);
+        }
+        catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    std::string trim(const std::string& s)
+    {
+        const char* ws = " \t\r";
+        std::size_t b = s.find_first_not_of(ws);
+        if (b == std::string::npos) {
+            return "";
+        }
+        return s.substr(b, s.find_last_not_of(ws) - b + 1);
+    }
+
+    std::vector<std::string> split_values(const std::string& s)
+    {
+        std::string spaced = s;
+        std::replace(spaced.begin(), spaced.end(), ',', ' ');
+        std::istringstream in(spaced);
+        std::vector<std::string> values;
+        std::string v;
+        while (in >> v) {
+            values.push_back(v);
+        }
+        return values;
+    }
+}
+
+std::size_t SweepCase::n_nodes() const {
+    if (!(length > 0 && dx > 0)) {
+        return 0;   // rejected by Grid1D when the case runs
+    }
+    return static_cast<std::size_t>(length / dx) + 1;
+}
+
+std::size_t SweepCase::n_steps() const {
+    if (!(dt > 0 && t_end > 0)) {
+        return 0;
+    }
+    return static_cast<std::size_t>(std::round(t_end / dt));
+}
+
+std::vector<SweepCase> SweepSpec::expand() const
+{
+    std::vector<SweepCase> out;
+    for (const std::string& scheme : schemes)
+    for (double length : lengths)
+    for (double dx : dxs)
+    for (double D : Ds)
+    for (double Tin : Tins)
+    for (double Tsur : Tsurs)
+    for (double dt : dts)
+    for (double t_end : t_ends) {
+        SweepCase c;
+        c.scheme = scheme;
+        c.length = length;
+        c.dx = dx;
+        c.D = D;
+        c.Tin = Tin;
+        c.Tsur = Tsur;
+        c.dt = dt;
+        c.t_end = t_end;
+        out.push_back(c);
+    }
+    return out;
+}
+
+void ParameterSweep::add_case(const SweepCase& c)
+{
+    cases_.push_back(c);
+}
+
+void ParameterSweep::add_product(const SweepSpec& spec)
+{
+    std::vector<SweepCase> expanded = spec.expand();
+    cases_.insert(cases_.end(), expanded.begin(), expanded.end());
+}
+
+void ParameterSweep::load(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open sweep spec: " + filename);
+    }
+
+    SweepSpec spec;
+    bool in_block = false;
+    std::string line;
+    std::size_t line_no = 0;
+
+    while (std::getline(file, line)) {
+        ++line_no;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            if (in_block) {
+                add_product(spec);
+                spec = SweepSpec();
+                in_block = false;
+            }
+            continue;
+        }
+
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(line_no)
+                + ": expected 'key = values'");
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::vector<std::string> values = split_values(line.substr(eq + 1));
+        if (values.empty()) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(line_no)
+                + ": no values for '" + key + "'");
+        }
+
+        if (key == "scheme") {
+            spec.schemes = values;
+        }
+        else {
+            std::vector<double> numbers;
+            for (const std::string& v : values) {
+                try {
+                    numbers.push_back(std::stod(v));
+                }
+                catch (const std::exception&) {
+                    throw std::runtime_error("Sweep spec line "
+                        + std::to_string(line_no) + ": bad number '" + v + "'");
+                }
+            }
+
+            if (key == "L") spec.lengths = numbers;
+            else if (key == "dx") spec.dxs = numbers;
+            else if (key == "D") spec.Ds = numbers;
+            else if (key == "Tin") spec.Tins = numbers;
+            else if (key == "Tsur") spec.Tsurs = numbers;
+            else if (key == "dt") spec.dts = numbers;
+            else if (key == "t_end") spec.t_ends = numbers;
+            else {
+                throw std::runtime_error("Sweep spec line " + std::to_string(line_no)
+                    + ": unknown key '" + key + "'");
+            }
+        }
+        in_block = true;
+    }
+
+    if (in_block) {
+        add_product(spec);
+    }
+}
+
+const std::vector<SweepCase>& ParameterSweep::cases() const {
+    return cases_;
+}
+
+std::vector<SweepResult> ParameterSweep::run(ThreadPool& pool) const
+{
+    // Longest processing time first
+    std::vector<std::size_t> order(cases_.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+        [this](std::size_t a, std::size_t b) {
+            return cases_[a].n_nodes() * cases_[a].n_steps()
+                 > cases_[b].n_nodes() * cases_[b].n_steps();
+        });
+
+    std::vector<SweepResult> results(cases_.size());
+    std::vector<std::future<void>> done;
+    done.reserve(cases_.size());
+
+    for (std::size_t k : order) {
+        done.push_back(pool.submit([this, k, &results] {
+            results[k] = run_case(cases_[k]);
+        }));
+    }
+    for (std::future<void>& f : done) {
+        f.get();
+    }
+
+    return results;
+}
+
+void ParameterSweep::write_csv(const std::vector<SweepResult>& results,
+    const std::string& filename)
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open output file: " + filename);
+    }
+
+    file << "scheme,L (cm),dx (cm),D (cm^2/hr),Tin,Tsur,dt (hr),t_end (hr),"
+        << "nodes,steps,seconds,max_error,rms_error,status\n";
+
+    file << std::setprecision(10);
+    for (const SweepResult& r : results) {
+        const SweepCase& c = r.params;
+        std::string status = !r.error.empty() ? r.error : (r.diverged ? "diverged" : "ok");
+        std::replace(status.begin(), status.end(), '"', '\'');
+
+        file << c.scheme << ","
+            << c.length << ","
+            << c.dx << ","
+            << c.D << ","
+            << c.Tin << ","
+            << c.Tsur << ","
+            << c.dt << ","
+            << c.t_end << ","
+            << r.n_nodes << ","
+            << r.n_steps << ","
+            << r.seconds << ","
+            << r.max_error << ","
+            << r.rms_error << ","
+            << "\"" << status << "\"\n";
+    }
+
+    file.close();
+
+    std::cout << "Sweep results written to: " << filename << "\n";
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ThreadPool.h"
+
+// One simulation case; defaults are the constants of the reference run.
+struct SweepCase {
+    std::string scheme = "CrankNicolson";
+    double length = 31.0;   // cm
+    double dx = 0.05;       // cm
+    double D = 93.0;        // cm^2/hr
+    double Tin = 38.0;
+    double Tsur = 149.0;
+    double dt = 0.01;       // hr
+    double t_end = 0.5;     // hr
+
+    std::size_t n_nodes() const;
+    std::size_t n_steps() const;
+};
+
+// Cartesian product of parameter values
+struct SweepSpec {
+    std::vector<std::string> schemes = { "Richardson", "DuFortFrankel",
+        "Laasonen", "CrankNicolson" };
+    std::vector<double> lengths = { 31.0 };
+    std::vector<double> dxs = { 0.05 };
+    std::vector<double> Ds = { 93.0 };
+    std::vector<double> Tins = { 38.0 };
+    std::vector<double> Tsurs = { 149.0 };
+    std::vector<double> dts = { 0.01 };
+    std::vector<double> t_ends = { 0.5 };
+
+    std::vector<SweepCase> expand() const;
+};
+
+struct SweepResult {
+    SweepCase params;
+    std::size_t n_nodes = 0;
+    std::size_t n_steps = 0;
+    double seconds = 0.0;     // wall time of this case (march + errors)
+    double max_error = 0.0;   // vs AnalyticalSolution at the final time
+    double rms_error = 0.0;
+    std::string error;        // empty if the case ran
+    bool diverged = false;    // non-finite, or far outside [Tin, Tsur]
+};
+
+// Runs many independent cases on a thread pool and collects one row per
+// case. Cases are started largest first (nodes x steps), which together
+// with work stealing keeps all workers busy until the end.
+class ParameterSweep {
+public:
+    void add_case(const SweepCase& c);
+    void add_product(const SweepSpec& spec);
+
+    // Spec file: blocks separated by blank lines, each block a Cartesian
+    // product of "key = v1, v2, ..." lines (keys: scheme, L, dx, D, Tin,
+    // Tsur, dt, t_end; '#' starts a comment). Keys missing from a block
+    // keep their SweepSpec defaults, so single-valued blocks list cases.
+    void load(const std::string& filename);
+
+    const std::vector<SweepCase>& cases() const;
+
+    // Results are in case order. A failing case records its message
+    // instead of aborting the sweep. Call from outside the pool.
+    std::vector<SweepResult> run(ThreadPool& pool = ThreadPool::shared()) const;
+
+    static void write_csv(const std::vector<SweepResult>& results,
+        const std::string& filename);
+
+private:
+    std::vector<SweepCase> cases_;
+};
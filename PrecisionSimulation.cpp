@@ -0,0 +1,227 @@
+#include "PrecisionSimulation.h"
+#include "Grid1D.h"
+#include "SchemeMethods.h"
+#include "TridiagonalSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // Interior sweep of a Stencils.h stencil over out[0..n) with out[i]
+    // centred on curr[i]; prev is read only if the stencil needs it.
+    // The levels never overlap; __restrict lets the compiler vectorize.
+    template <class Stencil, class Real>
+    void sweep(const Stencil& s, Real* __restrict out, const Real* __restrict curr,
+        const Real* __restrict prev, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = s(curr[i - 1], curr[i], curr[i + 1],
+                Stencil::reads_prev ? prev[i] : curr[i]);
+        }
+    }
+
+    // res = b - A x for A = tridiag(off, diag, off), n >= 1; formed in
+    // Real, stored in the precision of the correction solve
+    template <class Real, class SolveReal>
+    void residual(SolveReal* __restrict res, const Real* __restrict b,
+        const Real* __restrict x, Real diag, Real off, std::size_t n)
+    {
+        if (n == 1) {
+            res[0] = static_cast<SolveReal>(b[0] - diag * x[0]);
+            return;
+        }
+        res[0] = static_cast<SolveReal>(b[0] - (diag * x[0] + off * x[1]));
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            res[i] = static_cast<SolveReal>(b[i] - (diag * x[i] + off * (x[i - 1] + x[i + 1])));
+        }
+        res[n - 1] = static_cast<SolveReal>(b[n - 1] - (diag * x[n - 1] + off * x[n - 2]));
+    }
+}
+
+template <class Real, class SolveReal>
+PrecisionSimulation<Real, SolveReal>::PrecisionSimulation(const HeatProblem& problem,
+    const std::string& scheme_name,
+    double dt, double t_end)
+    : problem_(problem),
+    scheme_name_(scheme_name),
+    dt_(dt),
+    t_end_(t_end)
+{
+    const Grid1D& grid = problem.grid();
+    const std::size_t N = grid.size();
+    if (N < 3) {
+        throw std::runtime_error("PrecisionSimulation: grid too small (N < 3)");
+    }
+    if (!problem.constant_coefficients()) {
+        throw std::runtime_error("PrecisionSimulation: needs a uniform grid and a homogeneous wall");
+    }
+
+    const Real dx = static_cast<Real>(grid.dx());
+    r_ = static_cast<Real>(problem.diffusivity()) * static_cast<Real>(dt) / (dx * dx);
+    Tsur_ = static_cast<Real>(problem.Tsur());
+
+    for (std::vector<Real>& level : levels_) {
+        level.resize(N);
+    }
+
+    // Theta methods: the matrix depends on dt only, factor it once
+    const std::size_t n_internal = N - 2;
+    const bool known = visit_method(scheme_name, [&](auto method) {
+        using Method = decltype(method);
+        if constexpr (is_theta_method<Method>::value) {
+            const Real a = static_cast<Real>(Method::theta) * r_;
+            off_ = -a;
+            diag_ = Real(1) + Real(2) * a;
+            factorization_.factor(static_cast<SolveReal>(off_),
+                static_cast<SolveReal>(diag_), static_cast<SolveReal>(off_),
+                n_internal, TridiagonalSolver::partitions_for(n_internal));
+            if (mixed_precision) {
+                rhs_.resize(n_internal);
+                correction_.resize(n_internal);
+            }
+        }
+    });
+    if (!known) {
+        throw std::runtime_error("PrecisionSimulation: unknown scheme '" + scheme_name + "'");
+    }
+}
+
+template <class Real, class SolveReal>
+double PrecisionSimulation<Real, SolveReal>::run_to_end()
+{
+    // Initial condition at t = 0; n-1 is needed by the first step
+    std::fill(curr().begin(), curr().end(), static_cast<Real>(problem_.Tin()));
+    prev() = curr();
+    sweeps_ = 0;
+
+    int n_steps = static_cast<int>(std::round(t_end_ / dt_));
+    double t = 0.0;
+
+    visit_method(scheme_name_, [&](auto method) {
+        for (int n = 0; n < n_steps; ++n) {
+            step<decltype(method)>(n == 0);
+            head_ = (head_ + 1) % 3;
+            t += dt_;
+        }
+    });
+    return t;
+}
+
+template <class Real, class SolveReal>
+template <class Method>
+void PrecisionSimulation<Real, SolveReal>::step(bool first_step)
+{
+    const std::size_t N = curr().size();
+    const std::size_t n_internal = N - 2;
+    const Real r = r_;
+    const Real Tsur = Tsur_;
+    const Real* T_curr = curr().data();
+    const Real* T_prev = prev().data();
+    Real* T_next = next().data();
+
+    T_next[0] = Tsur;
+    T_next[N - 1] = Tsur;
+
+    if constexpr (is_theta_method<Method>::value) {
+        // Right-hand side with the weights (1 - theta) r on the neighbours
+        // and theta r on Tsur in the wall rows, as ThetaScheme
+        constexpr double theta = Method::theta;
+        if constexpr (theta == 1.0) {
+            std::copy(T_curr + 1, T_curr + N - 1, T_next + 1);
+        }
+        else {
+            const Real b = static_cast<Real>(1.0 - theta) * r;
+            sweep(BasicThreePointStencil<Real>{ b, Real(1) - Real(2) * b, b },
+                T_next + 1, T_curr + 1, T_prev + 1, n_internal);
+        }
+        const Real a = static_cast<Real>(theta) * r;
+        T_next[1] += a * Tsur;
+        T_next[N - 2] += a * Tsur;
+        solve(T_next + 1);
+    }
+    else {
+        if constexpr (Method::start_up != StartUp::None) {
+            // Start-up step of ExplicitScheme<Method> (n-1 does not exist yet)
+            if (first_step) {
+                const auto s = Method::start_up_stencil(r);
+                if constexpr (Method::start_up == StartUp::FirstStep) {
+                    // Tsur as the outer neighbour of the wall-adjacent nodes
+                    if (N > 4) {
+                        sweep(s, T_next + 2, T_curr + 2, T_prev + 2, N - 4);
+                    }
+                    T_next[1] = s(Tsur, T_curr[1], N > 3 ? T_curr[2] : Tsur, T_curr[1]);
+                    T_next[N - 2] = s(N > 3 ? T_curr[N - 3] : Tsur, T_curr[N - 2], Tsur,
+                        T_curr[N - 2]);
+                }
+                else {
+                    sweep(s, T_next + 1, T_curr + 1, T_prev + 1, n_internal);
+                }
+                return;
+            }
+        }
+        (void)first_step;
+        sweep(Method::stencil(r), T_next + 1, T_curr + 1, T_prev + 1, n_internal);
+    }
+}
+
+template <class Real, class SolveReal>
+void PrecisionSimulation<Real, SolveReal>::solve(Real* x)
+{
+    if constexpr (!mixed_precision) {
+        factorization_.solve(x);
+    }
+    else {
+        const std::size_t n = rhs_.size();
+        Real* b = rhs_.data();
+        SolveReal* w = correction_.data();
+
+        std::copy(x, x + n, b);
+        for (std::size_t i = 0; i < n; ++i) {
+            w[i] = static_cast<SolveReal>(b[i]);
+        }
+        factorization_.solve(w);
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = static_cast<Real>(w[i]);
+        }
+
+        // x += A^{-1} (b - A x) until the residual has reached rounding
+        // level, i.e. stops halving; the residual is formed in Real
+        Real previous = std::numeric_limits<Real>::infinity();
+        for (std::size_t sweep = 0; sweep < max_refinement_sweeps; ++sweep) {
+            residual(w, b, x, diag_, off_, n);
+            Real norm = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                norm = std::max(norm, std::abs(static_cast<Real>(w[i])));
+            }
+            if (norm == 0 || norm > previous / Real(2)) {
+                break;
+            }
+            previous = norm;
+
+            factorization_.solve(w);
+            for (std::size_t i = 0; i < n; ++i) {
+                x[i] += static_cast<Real>(w[i]);
+            }
+            ++sweeps_;
+        }
+    }
+}
+
+template <class Real, class SolveReal>
+void PrecisionSimulation<Real, SolveReal>::solution(std::vector<double>& T) const
+{
+    const std::vector<Real>& level = levels_[head_];
+    T.assign(level.begin(), level.end());
+}
+
+template <class Real, class SolveReal>
+std::size_t PrecisionSimulation<Real, SolveReal>::refinement_sweeps() const
+{
+    return sweeps_;
+}
+
+template class PrecisionSimulation<float>;
+template class PrecisionSimulation<double>;
+template class PrecisionSimulation<long double>;
+template class PrecisionSimulation<double, float>;
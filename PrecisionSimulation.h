@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "HeatProblem.h"
+#include "TridiagonalFactorization.h"
+
+// Runs a finite-difference method of SchemeMethods.h (Richardson,
+// DuFortFrankel, FTCS, Laasonen, CrankNicolson) from its descriptor, with
+// the time levels stored and updated in Real (float, double or long
+// double). The results follow the double schemes step for step, first-step
+// start-up and boundary handling included.
+// Uniform grids and homogeneous walls only.
+//
+// The problem (Grid1D, HeatProblem) and the time t stay in double: they are
+// inputs, not state. r = D dt / dx^2 and the stencil weights (the
+// descriptor's stencils built for Real, theta r) are formed in Real.
+//
+// With a SolveReal narrower than Real (e.g. <double, float>) the implicit
+// schemes factor and solve in SolveReal and recover Real accuracy by
+// iterative refinement: the residual b - A x is formed in Real and the
+// correction is solved with the narrow factorization, until the residual
+// stops shrinking.
+template <class Real, class SolveReal = Real>
+class PrecisionSimulation {
+public:
+    static constexpr bool mixed_precision = !std::is_same<Real, SolveReal>::value;
+
+    PrecisionSimulation(const HeatProblem& problem,
+        const std::string& scheme_name,
+        double dt, double t_end);
+
+    // Marches from the initial condition to t_end; returns the time reached.
+    double run_to_end();
+
+    // Solution after run_to_end(), rounded to double
+    void solution(std::vector<double>& T) const;
+
+    // Refinement sweeps of the last run, summed over the implicit steps
+    // (always 0 unless mixed_precision)
+    std::size_t refinement_sweeps() const;
+
+    // Upper bound on the sweeps of a single solve
+    static constexpr std::size_t max_refinement_sweeps = 10;
+
+private:
+    template <class Method>
+    void step(bool first_step);
+    void solve(Real* rhs);  // in place, n_internal rows
+
+    std::vector<Real>& prev() { return levels_[(head_ + 2) % 3]; }
+    std::vector<Real>& curr() { return levels_[head_]; }
+    std::vector<Real>& next() { return levels_[(head_ + 1) % 3]; }
+
+    const HeatProblem& problem_;
+    std::string scheme_name_;  // a method of SchemeMethods.h
+    double dt_;
+    double t_end_;
+    Real r_;
+    Real Tsur_;
+    std::array<std::vector<Real>, 3> levels_;  // n-1, n, n+1 ring
+    std::size_t head_ = 0;
+
+    // Theta methods: A = tridiag(off_, diag_, off_) on the interior
+    Real off_ = 0;
+    Real diag_ = 0;
+    BasicTridiagonalFactorization<SolveReal> factorization_;
+
+    // Mixed precision workspace
+    std::vector<Real> rhs_;
+    std::vector<SolveReal> correction_;
+    std::size_t sweeps_ = 0;
+};
+
+// Instantiated in PrecisionSimulation.cpp
+extern template class PrecisionSimulation<float>;
+extern template class PrecisionSimulation<double>;
+extern template class PrecisionSimulation<long double>;
+extern template class PrecisionSimulation<double, float>;
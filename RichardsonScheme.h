@@ -1,12 +1,27 @@
 #pragma once
-#include "TimeScheme.h"
+#include "ExplicitScheme.h"
 
-class RichardsonScheme : public TimeScheme {
-public:
-    explicit RichardsonScheme(const HeatProblem& problem);
+// Richardson (CTCS): T^{n+1} = T^{n-1} + 2r (T_{i-1} - 2 T_i + T_{i+1}),
+// with an FTCS start-up step at t = 0
+struct RichardsonMethod {
+    template <class Real>
+    static BasicRichardsonStencil<Real> stencil(Real r) { return { Real(2.0) * r }; }
 
-    void step(std::vector<double>& T_curr,
-        std::vector<double>& T_prev,
-        double t, double dt) override;
+    static constexpr StartUp start_up = StartUp::AtTimeZero;
+    template <class Real>
+    static BasicThreePointStencil<Real> start_up_stencil(Real r)
+    {
+        return { r, Real(1.0) - Real(2.0) * r, r };
+    }
+
+    static double update(double kl, double kr, double left, double centre,
+        double right, double prev)
+    {
+        return prev + 2.0 * (kl * (left - centre) + kr * (right - centre));
+    }
 };
 
+using RichardsonScheme = ExplicitScheme<RichardsonMethod>;
+
+extern template class ExplicitScheme<RichardsonMethod>;
+extern template class SchemeBase<RichardsonScheme>;
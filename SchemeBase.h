@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "TimeScheme.h"
+#include "TimeLevels.h"
+#include "ObserverPipeline.h"
+#include "StencilKernels.h"
+#include "Telemetry.h"
+
+// CRTP base of the built-in schemes. Derived provides
+//
+//     struct Coefficients;                          // per-run constants
+//     Coefficients coefficients(double dt);
+//     void kernel(const Coefficients& coef,
+//         const std::vector<double>& T_curr, const std::vector<double>& T_prev,
+//         std::vector<double>& T_next, double t);
+//
+// and advance() runs the whole time loop with the kernel called
+// non-virtually: r, N, Tsur, ... are computed once per run and the kernel is
+// inlined into the loop. Each scheme explicitly instantiates its base in
+// its own source file (and declares it extern in its header) so that the
+// loop is compiled where the kernel is visible.
+//
+// advance_observed() calls observed_kernel(), which by default runs
+// kernel() and reduces the new level afterwards. A scheme whose kernel
+// works strip by strip hides it with a version that reduces each strip
+// as it is written (see write_and_reduce).
+template <class Derived>
+class SchemeBase : public TimeScheme {
+public:
+    using TimeScheme::TimeScheme;
+
+    void step(const std::vector<double>& T_curr,
+        const std::vector<double>& T_prev,
+        std::vector<double>& T_next,
+        double t, double dt) override;
+
+    void advance(TimeLevels& levels, double& t, double dt,
+        std::size_t n_steps) override;
+
+    std::size_t advance_observed(TimeLevels& levels, double& t, double dt,
+        std::size_t n_steps, ObserverPipeline& observers) override;
+
+protected:
+    template <class Coefficients>
+    void observed_kernel(const Coefficients& coef,
+        const std::vector<double>& T_curr, const std::vector<double>& T_prev,
+        std::vector<double>& T_next, double t, StepStatistics& stats);
+};
+
+template <class Derived>
+void SchemeBase<Derived>::step(const std::vector<double>& T_curr,
+    const std::vector<double>& T_prev,
+    std::vector<double>& T_next,
+    double t, double dt)
+{
+    HEAT_SCOPED_TIMER(SchemeStep, 1, T_curr.size(), 24 * T_curr.size());
+
+    Derived& self = static_cast<Derived&>(*this);
+    self.kernel(self.coefficients(dt), T_curr, T_prev, T_next, t);
+}
+
+template <class Derived>
+void SchemeBase<Derived>::advance(TimeLevels& levels, double& t, double dt,
+    std::size_t n_steps)
+{
+    // One timer per run, not per step; 24 bytes = read n and n-1, write n+1
+    HEAT_SCOPED_TIMER(SchemeStep, n_steps, levels.size() * n_steps,
+        24 * levels.size() * n_steps);
+
+    Derived& self = static_cast<Derived&>(*this);
+    const auto coef = self.coefficients(dt);
+
+    for (std::size_t n = 0; n < n_steps; ++n) {
+        self.kernel(coef, levels.curr(), levels.prev(), levels.next(), t);
+        levels.rotate();
+        t += dt;
+    }
+}
+
+template <class Derived>
+std::size_t SchemeBase<Derived>::advance_observed(TimeLevels& levels, double& t,
+    double dt, std::size_t n_steps, ObserverPipeline& observers)
+{
+    HEAT_SCOPED_TIMER(SchemeStep, n_steps, levels.size() * n_steps,
+        24 * levels.size() * n_steps);
+
+    Derived& self = static_cast<Derived&>(*this);
+    const auto coef = self.coefficients(dt);
+
+    for (std::size_t n = 0; n < n_steps; ++n) {
+        StepStatistics stats;
+        self.observed_kernel(coef, levels.curr(), levels.prev(), levels.next(), t, stats);
+        levels.rotate();
+        t += dt;
+        if (!observers.after_step(t, levels.curr(), stats)) {
+            return n + 1;
+        }
+    }
+    return n_steps;
+}
+
+template <class Derived>
+template <class Coefficients>
+void SchemeBase<Derived>::observed_kernel(const Coefficients& coef,
+    const std::vector<double>& T_curr, const std::vector<double>& T_prev,
+    std::vector<double>& T_next, double t, StepStatistics& stats)
+{
+    static_cast<Derived&>(*this).kernel(coef, T_curr, T_prev, T_next, t);
+    if (T_curr.size() > 2) {
+        write_and_reduce(T_next.data() + 1, T_curr.data() + 1, T_curr.size() - 2,
+            stats, [](std::size_t, std::size_t) {});
+    }
+}
@@ -0,0 +1,19 @@
+#include "SchemeFactory.h"
+#include "SchemeMethods.h"
+#include "SpectralScheme.h"
+#include <stdexcept>
+
+std::unique_ptr<TimeScheme> make_scheme(const std::string& name,
+    const HeatProblem& problem)
+{
+    std::unique_ptr<TimeScheme> scheme;
+    if (visit_method(name, [&](auto method) {
+            scheme = std::make_unique<MethodScheme<decltype(method)>>(problem);
+        })) {
+        return scheme;
+    }
+    if (name == "Spectral") {
+        return std::make_unique<SpectralScheme>(problem);
+    }
+    throw std::runtime_error("make_scheme: unknown scheme '" + name + "'");
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "TimeScheme.h"
+
+class HeatProblem;
+
+// Creates one of the built-in schemes by the name used in the output
+// ("Richardson", "DuFortFrankel", "Laasonen", "CrankNicolson", "FTCS",
+// "Spectral").
+// Throws std::runtime_error for unknown names.
+std::unique_ptr<TimeScheme> make_scheme(const std::string& name,
+    const HeatProblem& problem);
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <type_traits>
+#include "RichardsonScheme.h"
+#include "DuFortFrankelScheme.h"
+#include "FtcsScheme.h"
+#include "LaasonenScheme.h"
+#include "CrankNicolsonScheme.h"
+
+// The finite-difference method descriptors by the names used in the output.
+// make_scheme() and the engines that march their own levels
+// (EnsembleSimulation, StreamingSimulation, PrecisionSimulation,
+// SubdomainSimulation) look methods up here, so a descriptor added to
+// visit_method() runs in every one of them.
+
+// Descriptors of ThetaScheme have a theta, those of ExplicitScheme a stencil
+template <class Method, class = void>
+struct is_theta_method : std::false_type {};
+
+template <class Method>
+struct is_theta_method<Method, std::void_t<decltype(Method::theta)>> : std::true_type {};
+
+// The scheme class generated from Method
+template <class Method>
+using MethodScheme = std::conditional_t<is_theta_method<Method>::value,
+    ThetaScheme<Method>, ExplicitScheme<Method>>;
+
+// Calls visit(Method{}) for the method called name; false if there is none
+template <class Visitor>
+bool visit_method(const std::string& name, Visitor&& visit)
+{
+    if (name == "Richardson") {
+        visit(RichardsonMethod{});
+    }
+    else if (name == "DuFortFrankel") {
+        visit(DuFortFrankelMethod{});
+    }
+    else if (name == "Laasonen") {
+        visit(LaasonenMethod{});
+    }
+    else if (name == "CrankNicolson") {
+        visit(CrankNicolsonMethod{});
+    }
+    else if (name == "FTCS") {
+        visit(FtcsMethod{});
+    }
+    else {
+        return false;
+    }
+    return true;
+}
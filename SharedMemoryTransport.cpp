@@ -0,0 +1,235 @@
+#include "SharedMemoryTransport.h"
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct SharedMemoryTransport::Ring {
+    alignas(64) std::atomic<std::uint64_t> head;   // values consumed
+    alignas(64) std::atomic<std::uint64_t> tail;   // values produced
+};
+
+struct SharedMemoryTransport::Segment {
+    alignas(64) std::atomic<int> aborted;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+    "shared-memory rings need lock-free 64-bit atomics");
+
+namespace {
+    constexpr std::size_t round_up(std::size_t n, std::size_t a)
+    {
+        return (n + a - 1) / a * a;
+    }
+}
+
+SharedMemoryTransport::SharedMemoryTransport(std::size_t n_ranks,
+    std::size_t ring_capacity)
+    : n_ranks_(n_ranks),
+    capacity_(ring_capacity),
+    ring_bytes_(round_up(sizeof(Ring) + ring_capacity * sizeof(double), 64))
+{
+    if (n_ranks_ == 0 || capacity_ == 0) {
+        throw std::runtime_error("SharedMemoryTransport: need at least one rank and a non-empty ring");
+    }
+
+    bytes_ = sizeof(Segment) + n_ranks_ * n_ranks_ * ring_bytes_;
+
+    // Named segment, unlinked right after mapping: the mapping survives
+    // fork() and the name never leaks
+    const std::string name = "/heat-" + std::to_string(::getpid()) + "-"
+        + std::to_string(reinterpret_cast<std::uintptr_t>(this));
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("SharedMemoryTransport: shm_open failed: " + std::string(std::strerror(errno)));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("SharedMemoryTransport: ftruncate failed");
+    }
+    base_ = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        throw std::runtime_error("SharedMemoryTransport: mmap failed");
+    }
+
+    new (base_) Segment{};
+    static_cast<Segment*>(base_)->aborted.store(0);
+    for (std::size_t from = 0; from < n_ranks_; ++from) {
+        for (std::size_t to = 0; to < n_ranks_; ++to) {
+            Ring* r = new (&ring(from, to)) Ring{};
+            r->head.store(0);
+            r->tail.store(0);
+        }
+    }
+}
+
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+    if (rank_ == 0 && !workers_.empty()) {
+        abort();
+        try {
+            join();
+        }
+        catch (...) {
+            // Destructors must not throw; call join() to see failures
+        }
+    }
+    if (base_) {
+        ::munmap(base_, bytes_);
+    }
+}
+
+std::size_t SharedMemoryTransport::launch()
+{
+    if (!workers_.empty() || rank_ != 0) {
+        throw std::runtime_error("SharedMemoryTransport::launch: already launched");
+    }
+    // Buffered output would otherwise be written once more by every worker
+    std::fflush(nullptr);
+    for (std::size_t r = 1; r < n_ranks_; ++r) {
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            abort();
+            try {
+                join();
+            }
+            catch (...) {
+                // The workers already forked fail on purpose
+            }
+            throw std::runtime_error("SharedMemoryTransport: fork failed");
+        }
+        if (pid == 0) {
+            rank_ = r;
+            workers_.clear();
+            return rank_;
+        }
+        workers_.push_back(pid);
+    }
+    return 0;
+}
+
+void SharedMemoryTransport::join()
+{
+    bool failed = false;
+    for (pid_t pid : workers_) {
+        int status = 0;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = true;
+        }
+    }
+    workers_.clear();
+
+    if (failed) {
+        throw std::runtime_error("SharedMemoryTransport: a worker process failed");
+    }
+}
+
+void SharedMemoryTransport::abort()
+{
+    static_cast<Segment*>(base_)->aborted.store(1, std::memory_order_release);
+}
+
+std::size_t SharedMemoryTransport::rank() const
+{
+    return rank_;
+}
+
+std::size_t SharedMemoryTransport::size() const
+{
+    return n_ranks_;
+}
+
+SharedMemoryTransport::Ring& SharedMemoryTransport::ring(std::size_t from,
+    std::size_t to) const
+{
+    char* rings = static_cast<char*>(base_) + sizeof(Segment);
+    return *reinterpret_cast<Ring*>(rings + (from * n_ranks_ + to) * ring_bytes_);
+}
+
+double* SharedMemoryTransport::ring_data(std::size_t from, std::size_t to) const
+{
+    return reinterpret_cast<double*>(reinterpret_cast<char*>(&ring(from, to)) + sizeof(Ring));
+}
+
+void SharedMemoryTransport::wait(unsigned& spins) const
+{
+    if (static_cast<Segment*>(base_)->aborted.load(std::memory_order_acquire)) {
+        throw std::runtime_error("SharedMemoryTransport: another rank failed");
+    }
+    // Halo messages usually arrive within microseconds; yield after a
+    // short spin so oversubscribed ranks still make progress
+    if (++spins > 256) {
+        std::this_thread::yield();
+    }
+}
+
+void SharedMemoryTransport::send(std::size_t to, const double* data,
+    std::size_t count)
+{
+    Ring& r = ring(rank_, to);
+    double* buffer = ring_data(rank_, to);
+    std::uint64_t tail = r.tail.load(std::memory_order_relaxed);
+    unsigned spins = 0;
+
+    while (count > 0) {
+        const std::uint64_t head = r.head.load(std::memory_order_acquire);
+        const std::size_t free = capacity_ - static_cast<std::size_t>(tail - head);
+        if (free == 0) {
+            wait(spins);
+            continue;
+        }
+        const std::size_t n = std::min(free, count);
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer[(tail + i) % capacity_] = data[i];
+        }
+        tail += n;
+        r.tail.store(tail, std::memory_order_release);
+        data += n;
+        count -= n;
+        spins = 0;
+    }
+}
+
+void SharedMemoryTransport::receive(std::size_t from, double* data,
+    std::size_t count)
+{
+    Ring& r = ring(from, rank_);
+    const double* buffer = ring_data(from, rank_);
+    std::uint64_t head = r.head.load(std::memory_order_relaxed);
+    unsigned spins = 0;
+
+    while (count > 0) {
+        const std::uint64_t tail = r.tail.load(std::memory_order_acquire);
+        const std::size_t available = static_cast<std::size_t>(tail - head);
+        if (available == 0) {
+            wait(spins);
+            continue;
+        }
+        const std::size_t n = std::min(available, count);
+        for (std::size_t i = 0; i < n; ++i) {
+            data[i] = buffer[(head + i) % capacity_];
+        }
+        head += n;
+        r.head.store(head, std::memory_order_release);
+        data += n;
+        count -= n;
+        spins = 0;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <sys/types.h>
+#include <vector>
+#include "Transport.h"
+
+// Transport between processes forked from one parent, through a POSIX
+// shared-memory segment holding one single-producer/single-consumer ring
+// of doubles per ordered pair of ranks. Waiting sides spin briefly, then
+// yield; if a rank calls abort(), every waiting rank throws instead of
+// hanging.
+//
+// Usage: construct in the parent, call launch() (fork), run the rank's
+// part on every process; workers leave with std::_Exit, the parent
+// calls join(). Linux/POSIX only.
+class SharedMemoryTransport : public Transport {
+public:
+    explicit SharedMemoryTransport(std::size_t n_ranks,
+        std::size_t ring_capacity = 1024);
+    ~SharedMemoryTransport() override;
+
+    SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+    SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+    // Forks size() - 1 workers; returns the rank of the calling process
+    // (0 in the parent). Only the calling thread is copied, so a worker
+    // must not use a thread pool the parent started (ThreadPool::shared()
+    // throws there).
+    std::size_t launch();
+
+    // Parent: waits for the workers; throws if one failed
+    void join();
+
+    // Marks the run as failed so that waiting ranks give up
+    void abort();
+
+    std::size_t rank() const override;
+    std::size_t size() const override;
+
+    void send(std::size_t to, const double* data, std::size_t count) override;
+    void receive(std::size_t from, double* data, std::size_t count) override;
+
+private:
+    struct Ring;
+    struct Segment;
+
+    Ring& ring(std::size_t from, std::size_t to) const;
+    double* ring_data(std::size_t from, std::size_t to) const;
+    void wait(unsigned& spins) const;
+
+    std::size_t n_ranks_;
+    std::size_t capacity_;
+    std::size_t ring_bytes_;
+    std::size_t rank_ = 0;
+    void* base_ = nullptr;
+    std::size_t bytes_ = 0;
+    std::vector<pid_t> workers_;
+};
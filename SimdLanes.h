@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define HEAT_X86 1
+#include <immintrin.h>
+#endif
+
+// Per-function instruction-set selection. GCC would otherwise fuse the
+// multiply/add pairs into FMAs under AVX-512 and change the rounding.
+#if defined(__clang__)
+#define HEAT_TARGET(isa) __attribute__((target(isa)))
+#elif defined(__GNUC__)
+#define HEAT_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#else
+#define HEAT_TARGET(isa)
+#endif
+
+// Forced inlining. Code that is generic over the lane type (the stencil
+// descriptors) is compiled for the default target; it must be inlined into
+// the HEAT_TARGET function that instantiates it, where the lane operators
+// can be inlined in turn.
+#if defined(__GNUC__) || defined(__clang__)
+#define HEAT_INLINE __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+#define HEAT_INLINE __forceinline
+#else
+#define HEAT_INLINE inline
+#endif
+
+// Packs of doubles with the arithmetic operators of double, so that one
+// expression template-instantiated for double and for each pack computes
+// the same operations in the same order on every lane. A double broadcasts
+// to all lanes; load() and store() are unaligned.
+#ifdef HEAT_X86
+
+struct Sse2Lanes {
+    static constexpr std::size_t width = 2;
+    __m128d v;
+
+    HEAT_TARGET("sse2") Sse2Lanes(__m128d x) : v(x) {}
+    HEAT_TARGET("sse2") Sse2Lanes(double x) : v(_mm_set1_pd(x)) {}
+    HEAT_TARGET("sse2") static Sse2Lanes load(const double* p) { return _mm_loadu_pd(p); }
+    HEAT_TARGET("sse2") void store(double* p) const { _mm_storeu_pd(p, v); }
+};
+
+HEAT_TARGET("sse2") inline Sse2Lanes operator+(const Sse2Lanes& a, const Sse2Lanes& b) { return _mm_add_pd(a.v, b.v); }
+HEAT_TARGET("sse2") inline Sse2Lanes operator-(const Sse2Lanes& a, const Sse2Lanes& b) { return _mm_sub_pd(a.v, b.v); }
+HEAT_TARGET("sse2") inline Sse2Lanes operator*(const Sse2Lanes& a, const Sse2Lanes& b) { return _mm_mul_pd(a.v, b.v); }
+HEAT_TARGET("sse2") inline Sse2Lanes operator/(const Sse2Lanes& a, const Sse2Lanes& b) { return _mm_div_pd(a.v, b.v); }
+
+struct Avx2Lanes {
+    static constexpr std::size_t width = 4;
+    __m256d v;
+
+    HEAT_TARGET("avx2") Avx2Lanes(__m256d x) : v(x) {}
+    HEAT_TARGET("avx2") Avx2Lanes(double x) : v(_mm256_set1_pd(x)) {}
+    HEAT_TARGET("avx2") static Avx2Lanes load(const double* p) { return _mm256_loadu_pd(p); }
+    HEAT_TARGET("avx2") void store(double* p) const { _mm256_storeu_pd(p, v); }
+};
+
+HEAT_TARGET("avx2") inline Avx2Lanes operator+(const Avx2Lanes& a, const Avx2Lanes& b) { return _mm256_add_pd(a.v, b.v); }
+HEAT_TARGET("avx2") inline Avx2Lanes operator-(const Avx2Lanes& a, const Avx2Lanes& b) { return _mm256_sub_pd(a.v, b.v); }
+HEAT_TARGET("avx2") inline Avx2Lanes operator*(const Avx2Lanes& a, const Avx2Lanes& b) { return _mm256_mul_pd(a.v, b.v); }
+HEAT_TARGET("avx2") inline Avx2Lanes operator/(const Avx2Lanes& a, const Avx2Lanes& b) { return _mm256_div_pd(a.v, b.v); }
+
+struct Avx512Lanes {
+    static constexpr std::size_t width = 8;
+    __m512d v;
+
+    HEAT_TARGET("avx512f") Avx512Lanes(__m512d x) : v(x) {}
+    HEAT_TARGET("avx512f") Avx512Lanes(double x) : v(_mm512_set1_pd(x)) {}
+    HEAT_TARGET("avx512f") static Avx512Lanes load(const double* p) { return _mm512_loadu_pd(p); }
+    HEAT_TARGET("avx512f") void store(double* p) const { _mm512_storeu_pd(p, v); }
+};
+
+HEAT_TARGET("avx512f") inline Avx512Lanes operator+(const Avx512Lanes& a, const Avx512Lanes& b) { return _mm512_add_pd(a.v, b.v); }
+HEAT_TARGET("avx512f") inline Avx512Lanes operator-(const Avx512Lanes& a, const Avx512Lanes& b) { return _mm512_sub_pd(a.v, b.v); }
+HEAT_TARGET("avx512f") inline Avx512Lanes operator*(const Avx512Lanes& a, const Avx512Lanes& b) { return _mm512_mul_pd(a.v, b.v); }
+HEAT_TARGET("avx512f") inline Avx512Lanes operator/(const Avx512Lanes& a, const Avx512Lanes& b) { return _mm512_div_pd(a.v, b.v); }
+
+#endif // HEAT_X86
@@ -1,7 +1,11 @@
 ﻿#include "Simulation.h"
 #include "Grid1D.h"
 #include "AnalyticalSolution.h"
+#include "Telemetry.h"
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <typeinfo>
 
 Simulation::Simulation(const HeatProblem& problem,
     std::unique_ptr<TimeScheme> scheme,
@@ -9,11 +13,16 @@ Simulation::Simulation(const HeatProblem& problem,
     : problem_(problem),
     scheme_(std::move(scheme)),
     dt_(dt),
-    t_end_(t_end)
+    t_end_(t_end),
+    levels_(problem.grid().size())
 {
-    std::size_t N = problem_.grid().size();
-    T_curr_.resize(N);
-    T_prev_.resize(N);
+    // Workspace is allocated here once; the time loop never allocates
+    scheme_->prepare(levels_.size());
+}
+
+void Simulation::set_temporal_blocking(const TemporalBlocking& blocking)
+{
+    blocking_ = blocking;
 }
 
 void Simulation::run(const std::string& scheme_name,
@@ -21,26 +30,188 @@ void Simulation::run(const std::string& scheme_name,
 {
     const Grid1D& grid = problem_.grid();
 
+    double t = run_to_end();
+
+    // levels_.curr() now holds the solution at time t ≈ t_end; composite
+    // walls are stored without a reference
+    std::vector<double> T_exact;
+    if (AnalyticalSolution::applies(problem_)) {
+        AnalyticalSolution(problem_).evaluate(grid, t, T_exact);
+    }
+
+    out.store_scheme_result(scheme_name, grid, levels_.curr(), T_exact);
+}
+
+double Simulation::run_to_end()
+{
+    // Storage may have been handed out by release_solution()
+    levels_.curr().resize(problem_.grid().size());
+
     // Initial condition at t = 0
-    problem_.set_initial_condition(T_curr_);
-    T_prev_ = T_curr_;   // for schemes that need n-1 at first step
+    problem_.set_initial_condition(levels_.curr());
+    levels_.prev() = levels_.curr();   // for schemes that need n-1 at first step
+    scheme_->reset_state();            // e.g. start-up flags of a previous run
+
+    return march_to_end(0.0, 0);
+}
+
+double Simulation::resume(const std::string& checkpoint_file)
+{
+    Checkpoint cp = Checkpoint::read(checkpoint_file);
+
+    if (cp.T_curr.size() != problem_.grid().size()) {
+        throw std::runtime_error("Simulation::resume: checkpoint grid size differs");
+    }
+    if (cp.dt != dt_) {
+        throw std::runtime_error("Simulation::resume: checkpoint dt differs");
+    }
+    if (cp.scheme != typeid(*scheme_).name()) {
+        throw std::runtime_error("Simulation::resume: checkpoint was written by another scheme");
+    }
+    if (cp.step > static_cast<std::uint64_t>(std::round(t_end_ / dt_))) {
+        throw std::runtime_error("Simulation::resume: checkpoint lies beyond t_end");
+    }
+
+    levels_.curr() = std::move(cp.T_curr);
+    levels_.prev() = std::move(cp.T_prev);
+    scheme_->load_state(cp.scheme_state);
 
-    AnalyticalSolution analytical(problem_);
+    return march_to_end(cp.t, static_cast<std::size_t>(cp.step));
+}
 
+double Simulation::march_to_end(double t, std::size_t step)
+{
     int n_steps = static_cast<int>(std::round(t_end_ / dt_));
-    double t = 0.0;
+    const std::size_t total = static_cast<std::size_t>(n_steps);
 
-    for (int n = 0; n < n_steps; ++n) {
-        scheme_->step(T_curr_, T_prev_, t, dt_);
-        t += dt_;
-        // IMPORTANT: no std::swap(T_curr_, T_prev_) here
+    HEAT_SCOPED_TIMER(Simulation, 1, levels_.size() * (total - step), 0);
+
+    if (!observers_.empty()) {
+        observers_.start(problem_, step, t, levels_.curr());
+    }
+
+    if (!snapshots_ && !checkpoints_) {
+        march(t, step, total - step);
+        if (!observers_.empty()) {
+            observers_.finish(t, levels_.curr());
+        }
+        return t;
+    }
+
+    // Chunks end on multiples of the snapshot and checkpoint intervals,
+    // counted from step 0, so a resumed run splits the march exactly like
+    // the original one. Both writers copy the state and return at once.
+    if (snapshots_) {
+        snapshots_->push(step, t, levels_.curr());
     }
+    while (step < total) {
+        std::size_t chunk = total - step;
+        if (snapshots_) {
+            chunk = std::min(chunk, snapshot_every_ - step % snapshot_every_);
+        }
+        if (checkpoints_) {
+            chunk = std::min(chunk, checkpoint_every_ - step % checkpoint_every_);
+        }
+        step += march(t, step, chunk);
 
-    // T_curr_ now holds the solution at time t ≈ t_end
-    std::vector<double> T_exact(grid.size());
-    for (std::size_t i = 0; i < grid.size(); ++i) {
-        T_exact[i] = analytical(grid.x(i), t);
+        // An early exit counts as the end of the run
+        const bool last = (step == total || observers_.stopped());
+        if (snapshots_ && (step % snapshot_every_ == 0 || last)) {
+            snapshots_->push(step, t, levels_.curr());
+        }
+        if (checkpoints_ && (step % checkpoint_every_ == 0 || last)) {
+            checkpoints_->submit(step, t, dt_, levels_, *scheme_);
+        }
+        if (last) {
+            break;
+        }
+    }
+    if (!observers_.empty()) {
+        observers_.finish(t, levels_.curr());
     }
+    return t;
+}
 
-    out.store_scheme_result(scheme_name, grid, T_curr_, T_exact);
+std::size_t Simulation::march(double& t, std::size_t first_step, std::size_t n_steps)
+{
+    // Observers see every step, so the march is not blocked
+    if (!observers_.empty()) {
+        return scheme_->advance_observed(levels_, t, dt_, n_steps, observers_);
+    }
+
+    std::size_t remaining = n_steps;
+
+    // Blocked kernels take over after the (unblocked) start-up step
+    if (blocking_ && blocking_->pays_off(levels_.size())
+        && remaining > 0 && (first_step > 0 || remaining > 1)) {
+        if (first_step == 0) {
+            scheme_->advance(levels_, t, dt_, 1);
+            --remaining;
+        }
+        bool blocked;
+        {
+            HEAT_SCOPED_TIMER(SchemeStep, remaining, levels_.size() * remaining,
+                24 * levels_.size() * remaining);
+            blocked = scheme_->step_blocked(levels_.curr(), levels_.prev(), t,
+                dt_, remaining, *blocking_);
+        }
+        if (blocked) {
+            for (; remaining > 0; --remaining) {
+                t += dt_;
+            }
+        }
+    }
+
+    // One virtual call; the time loop itself runs inside the scheme
+    scheme_->advance(levels_, t, dt_, remaining);
+    return n_steps;
+}
+
+void Simulation::set_checkpoints(CheckpointWriter& writer, std::size_t every)
+{
+    if (every == 0) {
+        throw std::runtime_error("Simulation::set_checkpoints: interval must be positive");
+    }
+    checkpoints_ = &writer;
+    checkpoint_every_ = every;
+}
+
+void Simulation::add_observer(Observer& observer, std::size_t every)
+{
+    observers_.add(observer, every);
+}
+
+bool Simulation::converged() const
+{
+    return observers_.stopped();
+}
+
+void Simulation::set_snapshots(SnapshotWriter& writer, std::size_t every)
+{
+    if (every == 0) {
+        throw std::runtime_error("Simulation::set_snapshots: interval must be positive");
+    }
+    snapshots_ = &writer;
+    snapshot_every_ = every;
+}
+
+const std::vector<double>& Simulation::solution() const
+{
+    return levels_.curr();
+}
+
+std::vector<double> Simulation::release_solution()
+{
+    return std::move(levels_.curr());
+}
+
+double Simulation::end_time(double dt, double t_end)
+{
+    // Same accumulation as the march, so the result matches it bit for bit
+    int n_steps = static_cast<int>(std::round(t_end / dt));
+    double t = 0.0;
+    for (int n = 0; n < n_steps; ++n) {
+        t += dt;
+    }
+    return t;
 }
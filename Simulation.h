@@ -1,9 +1,14 @@
 #pragma once
 #include <memory>
+#include <optional>
 #include <vector>
 #include "HeatProblem.h"
 #include "TimeScheme.h"
+#include "TimeLevels.h"
 #include "OutputManager.h"
+#include "SnapshotWriter.h"
+#include "CheckpointWriter.h"
+#include "ObserverPipeline.h"
 
 class Simulation {
 public:
@@ -11,14 +16,74 @@ public:
         std::unique_ptr<TimeScheme> scheme,
         double dt, double t_end);
 
+    // Marches to t_end and stores the result with its analytical reference
+    // (none for composite walls)
     void run(const std::string& scheme_name,
         OutputManager& out);
 
+    // Marches from the initial condition to t_end without evaluating the
+    // analytical reference; returns the time reached. May be called again
+    // on the same Simulation: each call starts a fresh run.
+    double run_to_end();
+
+    // Solution after run() / run_to_end()
+    const std::vector<double>& solution() const;
+
+    // Moves the solution out (no copy); solution() is empty until the
+    // next run
+    std::vector<double> release_solution();
+
+    // Time reached after marching round(t_end / dt) steps of dt
+    static double end_time(double dt, double t_end);
+
+    // Use cache-blocked time stepping where the scheme supports it
+    // (explicit schemes) and the grid is large enough for it to pay off
+    // (TemporalBlocking::pays_off); results are identical to plain stepping.
+    void set_temporal_blocking(const TemporalBlocking& blocking);
+
+    // Emit the profile at the start, every `every` steps and at the end to
+    // writer (which must outlive the runs)
+    void set_snapshots(SnapshotWriter& writer, std::size_t every);
+
+    // Hand the state every `every` steps and at the end to writer (which
+    // must outlive the runs)
+    void set_checkpoints(CheckpointWriter& writer, std::size_t every);
+
+    // Calls observer every `every` steps of the following runs (and after
+    // the last step). Once an observer has converged the run ends before
+    // t_end; the returned time is the one reached. With observers attached
+    // temporal blocking is not used.
+    void add_observer(Observer& observer, std::size_t every = 1);
+
+    // True if the last run was ended early by an observer
+    bool converged() const;
+
+    // Continues the run saved in a checkpoint up to this simulation's
+    // t_end, which may lie beyond the one of the run that wrote it. The
+    // checkpoint must come from the same scheme, grid size and dt. The
+    // marched schemes give results bit-identical to an uninterrupted run
+    // (SpectralScheme jumps from checkpoint to checkpoint). Returns the
+    // time reached.
+    double resume(const std::string& checkpoint_file);
+
 private:
+    // Steps from step index `step` at time t to round(t_end / dt), with
+    // snapshots and checkpoints on the way
+    double march_to_end(double t, std::size_t step);
+
+    // Up to n_steps steps starting at step index first_step; returns the
+    // steps taken (fewer once an observer has converged)
+    std::size_t march(double& t, std::size_t first_step, std::size_t n_steps);
+
     const HeatProblem& problem_;
     std::unique_ptr<TimeScheme> scheme_;
     double dt_;
     double t_end_;
-    std::vector<double> T_curr_;
-    std::vector<double> T_prev_;
-};
\ No newline at end of file
+    TimeLevels levels_;  // n-1, n, n+1 (rotated, never copied)
+    std::optional<TemporalBlocking> blocking_;
+    SnapshotWriter* snapshots_ = nullptr;
+    std::size_t snapshot_every_ = 0;
+    CheckpointWriter* checkpoints_ = nullptr;
+    std::size_t checkpoint_every_ = 0;
+    ObserverPipeline observers_;
+};
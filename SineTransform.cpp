@@ -0,0 +1,147 @@
+#include "SineTransform.h"
+#include <cmath>
+
+namespace {
+    constexpr double pi = 3.14159265358979323846;
+
+    std::size_t next_pow2(std::size_t n)
+    {
+        std::size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+}
+
+SineTransform::SineTransform(std::size_t n)
+{
+    resize(n);
+}
+
+std::size_t SineTransform::size() const {
+    return n_;
+}
+
+void SineTransform::resize(std::size_t n)
+{
+    n_ = n;
+    if (n == 0) {
+        len_ = m_ = 0;
+        return;
+    }
+
+    len_ = 2 * (n + 1);
+    bluestein_ = (next_pow2(len_) != len_);
+    m_ = bluestein_ ? next_pow2(2 * len_ - 1) : len_;
+
+    twiddle_.resize(m_ / 2);
+    for (std::size_t k = 0; k < m_ / 2; ++k) {
+        double angle = -2.0 * pi * static_cast<double>(k) / static_cast<double>(m_);
+        twiddle_[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    bitrev_.resize(m_);
+    std::size_t log2m = 0;
+    while ((std::size_t(1) << log2m) < m_) {
+        ++log2m;
+    }
+    for (std::size_t i = 0; i < m_; ++i) {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < log2m; ++b) {
+            r |= ((i >> b) & 1) << (log2m - 1 - b);
+        }
+        bitrev_[i] = r;
+    }
+
+    work_.assign(m_, Complex(0.0, 0.0));
+
+    if (bluestein_) {
+        // j^2 is reduced mod 2 len_ before scaling to keep the angle exact
+        chirp_.resize(len_);
+        for (std::size_t j = 0; j < len_; ++j) {
+            std::size_t j2 = (j * j) % (2 * len_);
+            double angle = -pi * static_cast<double>(j2) / static_cast<double>(len_);
+            chirp_[j] = Complex(std::cos(angle), std::sin(angle));
+        }
+
+        chirp_hat_.assign(m_, Complex(0.0, 0.0));
+        chirp_hat_[0] = std::conj(chirp_[0]);
+        for (std::size_t j = 1; j < len_; ++j) {
+            chirp_hat_[j] = chirp_hat_[m_ - j] = std::conj(chirp_[j]);
+        }
+        fft(chirp_hat_.data(), false);
+    }
+    else {
+        chirp_.clear();
+        chirp_hat_.clear();
+    }
+}
+
+void SineTransform::fft(Complex* a, bool inverse) const
+{
+    for (std::size_t i = 0; i < m_; ++i) {
+        if (i < bitrev_[i]) {
+            std::swap(a[i], a[bitrev_[i]]);
+        }
+    }
+
+    for (std::size_t half = 1; half < m_; half <<= 1) {
+        const std::size_t stride = m_ / (2 * half);
+        for (std::size_t start = 0; start < m_; start += 2 * half) {
+            for (std::size_t k = 0; k < half; ++k) {
+                Complex w = twiddle_[k * stride];
+                if (inverse) {
+                    w = std::conj(w);
+                }
+                Complex u = a[start + k];
+                Complex v = a[start + k + half] * w;
+                a[start + k] = u + v;
+                a[start + k + half] = u - v;
+            }
+        }
+    }
+}
+
+void SineTransform::transform(const double* in, double* out)
+{
+    if (n_ == 0) {
+        return;
+    }
+
+    // Odd extension: y = [0, x_1..x_n, 0, -x_n..-x_1]
+    Complex* y = work_.data();
+    y[0] = 0.0;
+    y[n_ + 1] = 0.0;
+    for (std::size_t j = 1; j <= n_; ++j) {
+        y[j] = in[j - 1];
+        y[len_ - j] = -in[j - 1];
+    }
+
+    if (!bluestein_) {
+        fft(y, false);
+    }
+    else {
+        // Y_k = c_k * sum_j (y_j c_j) conj(c_{k-j}),  c_j = exp(-pi i j^2 / len)
+        for (std::size_t j = 0; j < len_; ++j) {
+            y[j] *= chirp_[j];
+        }
+        for (std::size_t j = len_; j < m_; ++j) {
+            y[j] = 0.0;
+        }
+        fft(y, false);
+        for (std::size_t j = 0; j < m_; ++j) {
+            y[j] *= chirp_hat_[j];
+        }
+        fft(y, true);
+        const double scale = 1.0 / static_cast<double>(m_);
+        for (std::size_t k = 1; k <= n_; ++k) {
+            y[k] *= chirp_[k] * scale;
+        }
+    }
+
+    // Y_k = -2i * (DST-I)_k
+    for (std::size_t k = 1; k <= n_; ++k) {
+        out[k - 1] = -0.5 * y[k].imag();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Type-I discrete sine transform of length n in O(n log n):
+//   out[k-1] = sum_{j=1..n} in[j-1] * sin(pi j k / (n + 1)),  k = 1..n
+// It is its own inverse up to a factor 2 / (n + 1).
+//
+// Computed as the FFT of the odd extension (length 2(n + 1)); that FFT is
+// radix-2 when the length is a power of two and Bluestein's chirp-z
+// convolution (on radix-2 FFTs) otherwise. Twiddles, chirps and workspace
+// are set up once by resize(), so transform() does not allocate.
+class SineTransform {
+public:
+    explicit SineTransform(std::size_t n = 0);
+
+    void resize(std::size_t n);
+    std::size_t size() const;
+
+    // in and out may be the same array
+    void transform(const double* in, double* out);
+
+private:
+    using Complex = std::complex<double>;
+
+    // In-place radix-2 FFT (forward: exp(-2 pi i jk / m)) of length m_
+    void fft(Complex* a, bool inverse) const;
+
+    std::size_t n_ = 0;      // transform length
+    std::size_t len_ = 0;    // odd-extension length 2(n + 1)
+    std::size_t m_ = 0;      // radix-2 FFT length
+    bool bluestein_ = false;
+
+    std::vector<Complex> twiddle_;       // exp(-2 pi i k / m_), k < m_/2
+    std::vector<std::size_t> bitrev_;
+    std::vector<Complex> chirp_;         // exp(-pi i j^2 / len_), j < len_
+    std::vector<Complex> chirp_hat_;     // FFT of the conjugate chirp filter
+    std::vector<Complex> work_;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+
+// On-disk layout of snapshot files (native byte order):
+//
+//   SnapshotHeader                  64 bytes
+//   x coordinates                   n_nodes float64, in cm
+//   frame 0, frame 1, ...           frame_bytes each
+//
+// A frame is uint64 step, float64 t, then n_nodes values as float64 or
+// float32. With the delta flag, frames that are not keyframes (index not a
+// multiple of keyframe_interval) store the bitwise XOR with the previous
+// frame's values: lossless, and mostly zero bits for slowly varying fields,
+// so the files compress well. Frames are fixed-size, so frame i starts at
+// data_offset + i * frame_bytes.
+struct SnapshotHeader {
+    char magic[8];                 // "HEATSNAP"
+    std::uint32_t version;
+    std::uint32_t flags;           // SnapshotFlags
+    std::uint64_t n_nodes;
+    std::uint64_t n_frames;        // patched on close; readers use file size
+    std::uint64_t keyframe_interval;
+    std::uint64_t data_offset;     // first frame
+    std::uint64_t frame_bytes;
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must be 64 bytes");
+
+namespace SnapshotFlags {
+    constexpr std::uint32_t float32 = 1u << 0;
+    constexpr std::uint32_t delta = 1u << 1;
+}
+
+constexpr std::uint32_t snapshot_version = 1;
+constexpr std::uint64_t snapshot_frame_prefix = 16;   // step + t
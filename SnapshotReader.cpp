@@ -0,0 +1,180 @@
+#include "SnapshotReader.h"
+#include "SnapshotFormat.h"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SnapshotReader::SnapshotReader(const std::string& filename)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open snapshot file: " + filename);
+    }
+    file_handle_ = file;
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    if (size_ > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            throw std::runtime_error("Cannot map snapshot file: " + filename);
+        }
+        mapping_handle_ = mapping;
+        data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    fd_ = ::open(filename.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open snapshot file: " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot stat snapshot file: " + filename);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("Cannot map snapshot file: " + filename);
+        }
+        data_ = static_cast<const unsigned char*>(p);
+    }
+#endif
+
+    SnapshotHeader header;
+    if (size_ < sizeof(header)) {
+        unmap();
+        throw std::runtime_error("Not a snapshot file: " + filename);
+    }
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, "HEATSNAP", 8) != 0
+        || header.version != snapshot_version
+        || header.data_offset > size_) {
+        unmap();
+        throw std::runtime_error("Not a snapshot file: " + filename);
+    }
+
+    n_nodes_ = static_cast<std::size_t>(header.n_nodes);
+    flags_ = header.flags;
+    keyframe_interval_ = header.keyframe_interval ? header.keyframe_interval : 1;
+    data_offset_ = header.data_offset;
+    frame_bytes_ = header.frame_bytes;
+    n_frames_ = frame_bytes_ ? (size_ - data_offset_) / frame_bytes_ : 0;
+
+    x_.resize(n_nodes_);
+    std::memcpy(x_.data(), data_ + sizeof(header), n_nodes_ * sizeof(double));
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    unmap();
+}
+
+void SnapshotReader::unmap()
+{
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_) {
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    }
+    if (file_handle_) {
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+    }
+    mapping_handle_ = file_handle_ = nullptr;
+#else
+    if (data_) {
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+#endif
+    data_ = nullptr;
+}
+
+std::size_t SnapshotReader::n_nodes() const {
+    return n_nodes_;
+}
+
+std::size_t SnapshotReader::n_frames() const {
+    return n_frames_;
+}
+
+const std::vector<double>& SnapshotReader::x() const {
+    return x_;
+}
+
+const unsigned char* SnapshotReader::frame_data(std::size_t i) const
+{
+    return data_ + data_offset_ + i * frame_bytes_;
+}
+
+void SnapshotReader::frame(std::size_t i, std::vector<double>& T,
+    double* t, std::size_t* step) const
+{
+    if (i >= n_frames_) {
+        throw std::runtime_error("SnapshotReader::frame: index out of range");
+    }
+
+    const bool is_float32 = (flags_ & SnapshotFlags::float32) != 0;
+    const bool is_delta = (flags_ & SnapshotFlags::delta) != 0;
+
+    // Delta frames: XOR forward from the keyframe
+    std::size_t first = is_delta ? i - i % keyframe_interval_ : i;
+
+    T.resize(n_nodes_);
+    if (is_float32) {
+        std::vector<std::uint32_t> bits(n_nodes_, 0);
+        for (std::size_t f = first; f <= i; ++f) {
+            const unsigned char* values = frame_data(f) + snapshot_frame_prefix;
+            for (std::size_t j = 0; j < n_nodes_; ++j) {
+                std::uint32_t b;
+                std::memcpy(&b, values + 4 * j, 4);
+                bits[j] ^= b;
+            }
+        }
+        for (std::size_t j = 0; j < n_nodes_; ++j) {
+            float v;
+            std::memcpy(&v, &bits[j], 4);
+            T[j] = v;
+        }
+    }
+    else {
+        std::vector<std::uint64_t> bits(n_nodes_, 0);
+        for (std::size_t f = first; f <= i; ++f) {
+            const unsigned char* values = frame_data(f) + snapshot_frame_prefix;
+            for (std::size_t j = 0; j < n_nodes_; ++j) {
+                std::uint64_t b;
+                std::memcpy(&b, values + 8 * j, 8);
+                bits[j] ^= b;
+            }
+        }
+        std::memcpy(T.data(), bits.data(), n_nodes_ * 8);
+    }
+
+    const unsigned char* prefix = frame_data(i);
+    if (step) {
+        std::uint64_t s;
+        std::memcpy(&s, prefix, 8);
+        *step = static_cast<std::size_t>(s);
+    }
+    if (t) {
+        std::memcpy(t, prefix + 8, 8);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only access to a snapshot file (see SnapshotFormat.h) through a
+// memory mapping; frames are decoded on demand by index. Frames of a file
+// that is still being written (or was cut short) are counted from its size.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& filename);
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    std::size_t n_nodes() const;
+    std::size_t n_frames() const;
+    const std::vector<double>& x() const;   // cm
+
+    // Decodes frame i into T (resized); step and t are optional outputs.
+    // Delta frames are rebuilt from the preceding keyframe.
+    void frame(std::size_t i, std::vector<double>& T,
+        double* t = nullptr, std::size_t* step = nullptr) const;
+
+private:
+    const unsigned char* frame_data(std::size_t i) const;
+    void unmap();
+
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+
+    std::size_t n_nodes_ = 0;
+    std::size_t n_frames_ = 0;
+    std::uint32_t flags_ = 0;
+    std::uint64_t keyframe_interval_ = 1;
+    std::uint64_t data_offset_ = 0;
+    std::uint64_t frame_bytes_ = 0;
+    std::vector<double> x_;
+};
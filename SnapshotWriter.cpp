@@ -0,0 +1,187 @@
+#include "SnapshotWriter.h"
+#include "SnapshotFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+SnapshotWriter::SnapshotWriter(const std::string& filename,
+    const Grid1D& grid, const SnapshotOptions& options)
+    : file_(filename, std::ios::binary | std::ios::trunc),
+    n_nodes_(grid.size()),
+    options_(options),
+    filled_(std::max<std::size_t>(options.buffered_frames, 1)),
+    free_(std::max<std::size_t>(options.buffered_frames, 1))
+{
+    if (!file_.is_open()) {
+        throw std::runtime_error("Cannot open snapshot file: " + filename);
+    }
+    if (options_.keyframe_interval == 0) {
+        options_.keyframe_interval = 1;
+    }
+
+    const std::size_t value_bytes =
+        (options_.precision == SnapshotPrecision::Float32) ? 4 : 8;
+    frame_bytes_ = snapshot_frame_prefix + n_nodes_ * value_bytes;
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, "HEATSNAP", 8);
+    header.version = snapshot_version;
+    header.flags = 0;
+    if (options_.precision == SnapshotPrecision::Float32) {
+        header.flags |= SnapshotFlags::float32;
+    }
+    if (options_.delta) {
+        header.flags |= SnapshotFlags::delta;
+    }
+    header.n_nodes = n_nodes_;
+    header.n_frames = 0;
+    header.keyframe_interval = options_.keyframe_interval;
+    header.data_offset = sizeof(SnapshotHeader) + n_nodes_ * sizeof(double);
+    header.frame_bytes = frame_bytes_;
+
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.write(reinterpret_cast<const char*>(grid.coords().data()),
+        static_cast<std::streamsize>(n_nodes_ * sizeof(double)));
+
+    // All frame buffers are allocated here; push() only copies
+    frames_.resize(free_.capacity());
+    for (std::size_t i = 0; i < frames_.size(); ++i) {
+        frames_[i].values.resize(n_nodes_);
+        free_.try_push(i);
+    }
+    encoded_.resize(frame_bytes_);
+    previous_bits_.assign(n_nodes_, 0);
+
+    writer_ = std::thread([this] { writer_loop(); });
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    try {
+        close();
+    }
+    catch (...) {
+        // Destructors must not throw; call close() to see I/O errors
+    }
+}
+
+bool SnapshotWriter::push(std::size_t step, double t,
+    const std::vector<double>& T)
+{
+    if (T.size() != n_nodes_) {
+        throw std::runtime_error("SnapshotWriter::push: size mismatch");
+    }
+
+    std::size_t slot;
+    if (closed_ || !free_.try_pop(slot)) {
+        ++dropped_;
+        return false;
+    }
+
+    Frame& frame = frames_[slot];
+    frame.step = step;
+    frame.t = t;
+    std::copy(T.begin(), T.end(), frame.values.begin());
+
+    // Cannot fail: both queues hold at most frames_.size() indices
+    filled_.try_push(slot);
+    return true;
+}
+
+void SnapshotWriter::writer_loop()
+{
+    // Polls with a short back-off so that push() needs no lock or signal
+    auto idle = std::chrono::microseconds(50);
+    const auto max_idle = std::chrono::milliseconds(2);
+
+    for (;;) {
+        std::size_t slot;
+        if (filled_.try_pop(slot)) {
+            write_frame(frames_[slot]);
+            free_.try_push(slot);
+            idle = std::chrono::microseconds(50);
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire) && filled_.empty()) {
+            return;
+        }
+        std::this_thread::sleep_for(idle);
+        idle = std::min<std::chrono::microseconds>(idle * 2, max_idle);
+    }
+}
+
+void SnapshotWriter::write_frame(const Frame& frame)
+{
+    if (failed_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const std::size_t index = written_.load(std::memory_order_relaxed);
+    const bool xor_delta = options_.delta
+        && (index % options_.keyframe_interval) != 0;
+
+    unsigned char* out = encoded_.data();
+    std::memcpy(out, &frame.step, 8);
+    std::memcpy(out + 8, &frame.t, 8);
+    out += snapshot_frame_prefix;
+
+    if (options_.precision == SnapshotPrecision::Float32) {
+        for (std::size_t i = 0; i < n_nodes_; ++i) {
+            float v = static_cast<float>(frame.values[i]);
+            std::uint32_t bits;
+            std::memcpy(&bits, &v, 4);
+            std::uint32_t stored = xor_delta
+                ? bits ^ static_cast<std::uint32_t>(previous_bits_[i]) : bits;
+            previous_bits_[i] = bits;
+            std::memcpy(out + 4 * i, &stored, 4);
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < n_nodes_; ++i) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &frame.values[i], 8);
+            std::uint64_t stored = xor_delta ? bits ^ previous_bits_[i] : bits;
+            previous_bits_[i] = bits;
+            std::memcpy(out + 8 * i, &stored, 8);
+        }
+    }
+
+    file_.write(reinterpret_cast<const char*>(encoded_.data()),
+        static_cast<std::streamsize>(frame_bytes_));
+    if (!file_) {
+        failed_.store(true);
+        return;
+    }
+    written_.store(index + 1, std::memory_order_relaxed);
+}
+
+void SnapshotWriter::close()
+{
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    stopping_.store(true, std::memory_order_release);
+    writer_.join();
+
+    // Frame count in the header, for tools that do not look at file size
+    std::uint64_t n_frames = written_.load();
+    file_.seekp(offsetof(SnapshotHeader, n_frames));
+    file_.write(reinterpret_cast<const char*>(&n_frames), sizeof(n_frames));
+    file_.close();
+
+    if (failed_.load() || file_.fail()) {
+        throw std::runtime_error("SnapshotWriter: write error");
+    }
+}
+
+std::size_t SnapshotWriter::frames_written() const {
+    return written_.load();
+}
+
+std::size_t SnapshotWriter::frames_dropped() const {
+    return dropped_;
+}
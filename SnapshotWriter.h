@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Grid1D.h"
+#include "SpscQueue.h"
+
+enum class SnapshotPrecision { Float64, Float32 };
+
+struct SnapshotOptions {
+    SnapshotPrecision precision = SnapshotPrecision::Float64;
+    bool delta = false;                 // XOR with previous frame
+    std::size_t keyframe_interval = 32; // full frame every k frames (delta)
+    std::size_t buffered_frames = 64;   // frames in flight to the writer
+};
+
+// Appends solution snapshots to a binary file (see SnapshotFormat.h) from
+// a background thread. push() copies the profile into a preallocated frame
+// buffer and hands it over through a lock-free queue; when all buffers are
+// in flight the snapshot is dropped and counted, so the solver never waits
+// for the disk. One thread may push; close() (or the destructor) drains the
+// queue and finalizes the file.
+class SnapshotWriter {
+public:
+    SnapshotWriter(const std::string& filename, const Grid1D& grid,
+        const SnapshotOptions& options = SnapshotOptions());
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Returns false if the snapshot was dropped
+    bool push(std::size_t step, double t, const std::vector<double>& T);
+
+    // Writes everything queued and closes the file; throws on I/O errors
+    void close();
+
+    std::size_t frames_written() const;
+    std::size_t frames_dropped() const;
+
+private:
+    struct Frame {
+        std::uint64_t step = 0;
+        double t = 0.0;
+        std::vector<double> values;
+    };
+
+    void writer_loop();
+    void write_frame(const Frame& frame);
+
+    std::ofstream file_;
+    std::size_t n_nodes_;
+    SnapshotOptions options_;
+    std::uint64_t frame_bytes_;
+
+    std::vector<Frame> frames_;
+    SpscQueue<std::size_t> filled_;   // solver -> writer
+    SpscQueue<std::size_t> free_;     // writer -> solver
+
+    // Writer-thread state
+    std::vector<unsigned char> encoded_;
+    std::vector<std::uint64_t> previous_bits_;
+
+    std::atomic<bool> stopping_{ false };
+    std::atomic<bool> failed_{ false };
+    std::atomic<std::size_t> written_{ 0 };
+    std::size_t dropped_ = 0;
+    bool closed_ = false;
+    std::thread writer_;
+};
@@ -0,0 +1,148 @@
+#include "SpectralScheme.h"
+#include "HeatProblem.h"
+#include "Grid1D.h"
+#include "TimeLevels.h"
+#include "Telemetry.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    constexpr double pi = 3.14159265358979323846;
+}
+
+SpectralScheme::SpectralScheme(const HeatProblem& problem, SpectralDecay decay)
+    : TimeScheme(problem), decay_(decay) {
+}
+
+void SpectralScheme::prepare(std::size_t N)
+{
+    if (N < 3) {
+        throw std::runtime_error("SpectralScheme::prepare: grid too small (N < 3)");
+    }
+    if (!problem_.constant_coefficients()) {
+        throw std::runtime_error("SpectralScheme::prepare: the sine basis needs a uniform grid and a homogeneous wall");
+    }
+
+    dst_.resize(N - 2);
+    modes_.resize(N - 2);
+    scaled_.resize(N - 2);
+}
+
+void SpectralScheme::analyse(const std::vector<double>& T0)
+{
+    const std::size_t n_internal = T0.size() - 2;
+    if (dst_.size() != n_internal) {
+        prepare(T0.size());
+    }
+
+    const double Tsur = problem_.Tsur();
+    for (std::size_t j = 0; j < n_internal; ++j) {
+        modes_[j] = T0[j + 1] - Tsur;
+    }
+    left_excess_ = T0.front() - Tsur;
+    right_excess_ = T0.back() - Tsur;
+    dst_.transform(modes_.data(), modes_.data());
+}
+
+void SpectralScheme::synthesise(std::vector<double>& T, double dt,
+    std::size_t n_steps)
+{
+    const Grid1D& grid = problem_.grid();
+    const std::size_t N = grid.size();
+    const std::size_t n_internal = N - 2;
+
+    const double dx = grid.dx();
+    const double D = problem_.diffusivity();
+    const double Tsur = problem_.Tsur();
+    const double elapsed = dt * static_cast<double>(n_steps);
+    const double r = D * dt / (dx * dx);
+    const double n_d = static_cast<double>(n_steps);
+
+    // Mode k is sin(k pi x / Lb) on the node span Lb = (N - 1) dx
+    const double Lb = static_cast<double>(N - 1) * dx;
+
+    for (std::size_t k = 1; k <= n_internal; ++k) {
+        double k_d = static_cast<double>(k);
+        double s = std::sin(k_d * pi / (2.0 * static_cast<double>(N - 1)));
+        double s2 = s * s;
+
+        double g = 1.0;
+        switch (decay_) {
+        case SpectralDecay::Exact: {
+            double kPiL = k_d * pi / Lb;
+            g = std::exp(-D * kPiL * kPiL * elapsed);
+            break;
+        }
+        case SpectralDecay::SemiDiscrete:
+            g = std::exp(-4.0 * D * s2 / (dx * dx) * elapsed);
+            break;
+        case SpectralDecay::Laasonen:
+            g = std::pow(1.0 + 4.0 * r * s2, -n_d);
+            break;
+        case SpectralDecay::CrankNicolson:
+            g = std::pow((1.0 - 2.0 * r * s2) / (1.0 + 2.0 * r * s2), n_d);
+            break;
+        }
+
+        scaled_[k - 1] = modes_[k - 1] * g;
+
+        // Crank-Nicolson's first step takes its explicit-half boundary
+        // values from T0 (later steps see Tsur). The difference acts as a
+        // source (r/2) * excess on the edge rows, whose DST-I is closed form.
+        if (decay_ == SpectralDecay::CrankNicolson && n_steps > 0) {
+            double g1 = (1.0 - 2.0 * r * s2) / (1.0 + 2.0 * r * s2);
+            double sk = std::sin(k_d * pi / static_cast<double>(N - 1));
+            double sign = (k % 2 == 1) ? 1.0 : -1.0;
+            double source = 0.5 * r * sk * (left_excess_ + sign * right_excess_);
+            scaled_[k - 1] += std::pow(g1, n_d - 1.0) * source / (1.0 + 2.0 * r * s2);
+        }
+    }
+
+    // DST-I is its own inverse up to 2 / (n + 1)
+    dst_.transform(scaled_.data(), scaled_.data());
+    const double norm = 2.0 / static_cast<double>(n_internal + 1);
+
+    T.resize(N);
+    T[0] = Tsur;
+    for (std::size_t j = 0; j < n_internal; ++j) {
+        T[j + 1] = Tsur + norm * scaled_[j];
+    }
+    T[N - 1] = Tsur;
+}
+
+void SpectralScheme::evolve(const std::vector<double>& T0,
+    std::vector<double>& T, double dt, std::size_t n_steps)
+{
+    analyse(T0);
+    synthesise(T, dt, n_steps);
+}
+
+void SpectralScheme::step(const std::vector<double>& T_curr,
+    const std::vector<double>& /*T_prev*/,
+    std::vector<double>& T_next,
+    double /*t*/, double dt)
+{
+    HEAT_SCOPED_TIMER(SchemeStep, 1, T_curr.size(), 0);
+    evolve(T_curr, T_next, dt, 1);
+}
+
+void SpectralScheme::advance(TimeLevels& levels, double& t, double dt,
+    std::size_t n_steps)
+{
+    if (n_steps == 0) {
+        return;
+    }
+
+    HEAT_SCOPED_TIMER(SchemeStep, n_steps, levels.size() * n_steps, 0);
+
+    // curr is consumed by analyse(), so it can take level n - 1 before the
+    // ring rotates it into the prev slot
+    analyse(levels.curr());
+    synthesise(levels.curr(), dt, n_steps - 1);
+    synthesise(levels.next(), dt, n_steps);
+    levels.rotate();
+
+    for (std::size_t n = 0; n < n_steps; ++n) {
+        t += dt;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "TimeScheme.h"
+#include "SineTransform.h"
+
+// Decay factor applied to sine mode k over n steps of dt
+enum class SpectralDecay {
+    Exact,          // exp(-D (k pi / L)^2 n dt): the PDE itself
+    SemiDiscrete,   // exp(-lambda_k n dt), lambda_k of the 3-point Laplacian
+    Laasonen,       // (1 + 4 r s_k^2)^-n, s_k = sin(k pi / 2(N-1))
+    CrankNicolson   // ((1 - 2 r s_k^2) / (1 + 2 r s_k^2))^n
+};
+
+// Solves the problem in the discrete sine basis, where it is diagonal:
+// the interior excess T - Tsur is transformed once (DST-I), every mode is
+// scaled by its decay factor for the whole elapsed time, and the result is
+// transformed back. Any number of steps costs O(N log N).
+// With the Laasonen / CrankNicolson factors the result equals marching that
+// scheme (up to round-off). Needs a uniform grid and a homogeneous wall.
+class SpectralScheme : public TimeScheme {
+public:
+    explicit SpectralScheme(const HeatProblem& problem,
+        SpectralDecay decay = SpectralDecay::Exact);
+
+    void prepare(std::size_t N) override;
+
+    void step(const std::vector<double>& T_curr,
+        const std::vector<double>& T_prev,
+        std::vector<double>& T_next,
+        double t, double dt) override;
+
+    // One jump over all n_steps; prev receives level n_steps - 1
+    void advance(TimeLevels& levels, double& t, double dt,
+        std::size_t n_steps) override;
+
+    // Profile T after n_steps steps of dt starting from T0
+    void evolve(const std::vector<double>& T0, std::vector<double>& T,
+        double dt, std::size_t n_steps);
+
+private:
+    // Transforms the interior excess of T0 into modes_
+    void analyse(const std::vector<double>& T0);
+
+    // T = Tsur + inverse transform of modes_ scaled for n_steps of dt
+    void synthesise(std::vector<double>& T, double dt, std::size_t n_steps);
+
+    SpectralDecay decay_;
+    SineTransform dst_;
+    std::vector<double> modes_;     // DST-I of T0 - Tsur, interior nodes
+    std::vector<double> scaled_;    // workspace
+    double left_excess_ = 0.0;      // T0 - Tsur at the two boundary nodes
+    double right_excess_ = 0.0;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+// Neither side ever blocks: try_push fails when full, try_pop when empty.
+template<class T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : slots_(capacity + 1) {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return slots_.size() - 1; }
+
+    // Producer side
+    bool try_push(const T& value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t next = increment(tail);
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;   // full
+        }
+        slots_[tail] = value;
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T& value)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;   // empty
+        }
+        value = slots_[head];
+        head_.store(increment(head), std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire)
+            == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::size_t increment(std::size_t i) const
+    {
+        return (i + 1 == slots_.size()) ? 0 : i + 1;
+    }
+
+    std::vector<T> slots_;   // one slot stays empty to tell full from empty
+    alignas(64) std::atomic<std::size_t> head_{ 0 };   // next slot to pop
+    alignas(64) std::atomic<std::size_t> tail_{ 0 };   // next slot to push
+};
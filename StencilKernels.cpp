@@ -0,0 +1,222 @@
+#include "StencilKernels.h"
+#include "SimdLanes.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(HEAT_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+    // ----- Scalar reference kernels (also used for the vector tails) -----
+
+    // max(m, d) that keeps a NaN of either argument
+    inline double max_keep_nan(double m, double d)
+    {
+        return (d > m || std::isnan(d)) ? d : m;
+    }
+
+    // Reduction of out[i..n) into the partial sums s[i % 8] and the max m;
+    // the vector variants use it for their tails
+    void reduce_tail(const double* out, const double* curr,
+        std::size_t i, std::size_t n, double* s, double& m)
+    {
+        for (; i < n; ++i) {
+            const double d = std::fabs(out[i] - curr[i]);
+            m = max_keep_nan(m, d);
+            s[i % 8] += out[i];
+        }
+    }
+
+    void reduce_finish(const double* s, double m, StepStatistics& stats)
+    {
+        stats.max_change = max_keep_nan(stats.max_change, m);
+        stats.sum += ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+    }
+
+    void reduce_change_scalar(const double* out, const double* curr,
+        std::size_t n, StepStatistics& stats)
+    {
+        double s[8] = {};
+        double m = 0.0;
+        reduce_tail(out, curr, 0, n, s, m);
+        reduce_finish(s, m, stats);
+    }
+
+#ifdef HEAT_X86
+
+    // ----- SSE2 (2 lanes) -----
+
+    HEAT_TARGET("sse2")
+    void reduce_change_sse2(const double* out, const double* curr,
+        std::size_t n, StepStatistics& stats)
+    {
+        const __m128d sign = _mm_set1_pd(-0.0);
+        __m128d sum[4] = { _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd() };
+        __m128d max = _mm_setzero_pd();
+        __m128d nan = _mm_setzero_pd();  // lanes that saw a NaN change
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (int k = 0; k < 4; ++k) {
+                __m128d v = _mm_loadu_pd(out + i + 2 * k);
+                __m128d d = _mm_andnot_pd(sign, _mm_sub_pd(v, _mm_loadu_pd(curr + i + 2 * k)));
+                max = _mm_max_pd(max, d);
+                nan = _mm_or_pd(nan, _mm_cmpunord_pd(d, d));
+                sum[k] = _mm_add_pd(sum[k], v);
+            }
+        }
+        double s[8], m[2];
+        for (int k = 0; k < 4; ++k) {
+            _mm_storeu_pd(s + 2 * k, sum[k]);
+        }
+        _mm_storeu_pd(m, max);
+        double mx = max_keep_nan(m[0], m[1]);
+        if (_mm_movemask_pd(nan)) {
+            mx = std::numeric_limits<double>::quiet_NaN();
+        }
+        reduce_tail(out, curr, i, n, s, mx);
+        reduce_finish(s, mx, stats);
+    }
+
+    // ----- AVX2 (4 lanes) -----
+
+    HEAT_TARGET("avx2")
+    void reduce_change_avx2(const double* out, const double* curr,
+        std::size_t n, StepStatistics& stats)
+    {
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        __m256d sum[2] = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+        __m256d max = _mm256_setzero_pd();
+        __m256d nan = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (int k = 0; k < 2; ++k) {
+                __m256d v = _mm256_loadu_pd(out + i + 4 * k);
+                __m256d d = _mm256_andnot_pd(sign,
+                    _mm256_sub_pd(v, _mm256_loadu_pd(curr + i + 4 * k)));
+                max = _mm256_max_pd(max, d);
+                nan = _mm256_or_pd(nan, _mm256_cmp_pd(d, d, _CMP_UNORD_Q));
+                sum[k] = _mm256_add_pd(sum[k], v);
+            }
+        }
+        double s[8], m[4];
+        _mm256_storeu_pd(s, sum[0]);
+        _mm256_storeu_pd(s + 4, sum[1]);
+        _mm256_storeu_pd(m, max);
+        double mx = 0.0;
+        for (double v : m) {
+            mx = max_keep_nan(mx, v);
+        }
+        if (_mm256_movemask_pd(nan)) {
+            mx = std::numeric_limits<double>::quiet_NaN();
+        }
+        reduce_tail(out, curr, i, n, s, mx);
+        reduce_finish(s, mx, stats);
+    }
+
+    // ----- AVX-512 (8 lanes) -----
+
+    HEAT_TARGET("avx512f")
+    void reduce_change_avx512(const double* out, const double* curr,
+        std::size_t n, StepStatistics& stats)
+    {
+        const __m512i magnitude = _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL);
+        __m512d sum = _mm512_setzero_pd();
+        __m512d max = _mm512_setzero_pd();
+        __mmask8 nan = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512d v = _mm512_loadu_pd(out + i);
+            __m512i d = _mm512_castpd_si512(_mm512_sub_pd(v, _mm512_loadu_pd(curr + i)));
+            __m512d change = _mm512_castsi512_pd(_mm512_and_epi64(d, magnitude));
+            // maskz_: GCC 12 warns about the undefined source of _mm512_max_pd
+            max = _mm512_maskz_max_pd(0xFF, max, change);
+            nan |= _mm512_cmp_pd_mask(change, change, _CMP_UNORD_Q);
+            sum = _mm512_add_pd(sum, v);
+        }
+        double s[8], m[8];
+        _mm512_storeu_pd(s, sum);
+        _mm512_storeu_pd(m, max);
+        double mx = 0.0;
+        for (double v : m) {
+            mx = max_keep_nan(mx, v);
+        }
+        if (nan) {
+            mx = std::numeric_limits<double>::quiet_NaN();
+        }
+        reduce_tail(out, curr, i, n, s, mx);
+        reduce_finish(s, mx, stats);
+    }
+
+#endif // HEAT_X86
+
+    SimdLevel detect_cpu()
+    {
+#if defined(HEAT_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+        return SimdLevel::Scalar;
+#elif defined(HEAT_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int max_leaf = info[0];
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] & (1 << 26)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave || max_leaf < 7) {
+            return sse2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+        }
+        // Registers enabled by the OS: YMM (bits 1-2), ZMM (bits 5-7)
+        const unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) return SimdLevel::AVX512;
+        if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) return SimdLevel::AVX2;
+        return sse2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    SimdLevel requested_cap()
+    {
+        const char* env = std::getenv("HEAT_SIMD");
+        if (env == nullptr) return SimdLevel::AVX512;
+        if (std::strcmp(env, "scalar") == 0) return SimdLevel::Scalar;
+        if (std::strcmp(env, "sse2") == 0) return SimdLevel::SSE2;
+        if (std::strcmp(env, "avx2") == 0) return SimdLevel::AVX2;
+        return SimdLevel::AVX512;
+    }
+
+    StencilKernels select_kernels()
+    {
+        SimdLevel level = detect_cpu();
+        SimdLevel cap = requested_cap();
+        if (cap < level) {
+            level = cap;
+        }
+
+        switch (level) {
+#ifdef HEAT_X86
+        case SimdLevel::AVX512:
+            return { "avx512", SimdLevel::AVX512, reduce_change_avx512 };
+        case SimdLevel::AVX2:
+            return { "avx2", SimdLevel::AVX2, reduce_change_avx2 };
+        case SimdLevel::SSE2:
+            return { "sse2", SimdLevel::SSE2, reduce_change_sse2 };
+#endif
+        default:
+            return { "scalar", SimdLevel::Scalar, reduce_change_scalar };
+        }
+    }
+}
+
+const StencilKernels& stencil_kernels()
+{
+    static const StencilKernels kernels = select_kernels();
+    return kernels;
+}
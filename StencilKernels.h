@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include "StepStatistics.h"
+
+// Instruction sets with kernels compiled into the binary
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+// Interior kernels of the finite-difference schemes that are not generated
+// from a stencil descriptor (see StencilSweep.h). All pointers address the
+// first interior node (index 1 of the full grid).
+//
+// One implementation per instruction set (scalar, SSE2, AVX2, AVX-512) is
+// compiled into the binary and the fastest one supported by the CPU is
+// picked on first use. Every variant performs the same operations in the
+// same order (no FMA contraction), so results do not depend on the host.
+struct StencilKernels {
+    const char* isa;
+    SimdLevel level;
+
+    // stats.max_change = max(stats.max_change, |out[i] - curr[i]|),
+    // stats.sum += sum of out[i]. The max is NaN if any change is (a NaN
+    // level or inf - inf), so a diverged run never looks steady. The sum
+    // is formed from 8 partial sums (i mod 8) combined in a fixed order in
+    // every variant.
+    void (*reduce_change)(const double* out, const double* curr,
+        std::size_t n, StepStatistics& stats);
+};
+
+// Kernels selected for this CPU. The HEAT_SIMD environment variable
+// (scalar, sse2, avx2, avx512) caps the selection, e.g. for testing.
+const StencilKernels& stencil_kernels();
+
+// Strip length of the fused reductions: three strips of 8 KiB stay in L1
+constexpr std::size_t reduction_strip = 1024;
+
+// Calls write(offset, count) for consecutive strips of [0, n) and reduces
+// each strip of out against curr right after it has been written, while it
+// is still in L1. A no-op write reduces a level written beforehand, with
+// the same strips and hence the same statistics.
+template <class Write>
+void write_and_reduce(double* out, const double* curr, std::size_t n,
+    StepStatistics& stats, Write&& write)
+{
+    const StencilKernels& kernels = stencil_kernels();
+    for (std::size_t i = 0; i < n; i += reduction_strip) {
+        const std::size_t count = (n - i < reduction_strip) ? n - i : reduction_strip;
+        write(i, count);
+        kernels.reduce_change(out + i, curr + i, count, stats);
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include "SimdLanes.h"
+#include "StencilKernels.h"
+
+// Interior sweeps generated from stencil descriptors. A descriptor is a
+// small copyable struct holding its weights, with
+//
+//     static constexpr bool reads_prev;  // uses level n-1
+//     template <class V>
+//     HEAT_INLINE V operator()(const V& left, const V& centre,
+//         const V& right, const V& prev) const;
+//
+// returning T^{n+1}_i from T^n_{i-1}, T^n_i, T^n_{i+1} and T^{n-1}_i (prev
+// is T^n_i if !reads_prev). V is double or one of the SimdLanes packs, so
+// the expression is written once and compiled for every instruction set;
+// see Stencils.h for the built-in ones.
+//
+// A sweep writes out[0..n) and reads curr[-1..n] (and prev[0..n)), with the
+// pointers at the first interior node like the StencilKernels. Each
+// instruction set gets its own instantiation: packs, then a scalar tail
+// with the same expression, so results do not depend on the host.
+template <class Stencil>
+using StencilSweep = void (*)(const Stencil& stencil, double* out,
+    const double* curr, const double* prev, std::size_t n);
+
+namespace stencil_sweep_detail {
+    template <class Stencil>
+    HEAT_INLINE void tail(const Stencil& s, double* out, const double* curr,
+        const double* prev, std::size_t i, std::size_t n)
+    {
+        for (; i < n; ++i) {
+            out[i] = s(curr[i - 1], curr[i], curr[i + 1], Stencil::reads_prev ? prev[i] : curr[i]);
+        }
+    }
+
+    // Whole packs of [i, n); leaves i at the first node of the tail
+    template <class Lanes, class Stencil>
+    HEAT_INLINE void packs(const Stencil& s, double* out, const double* curr,
+        const double* prev, std::size_t& i, std::size_t n)
+    {
+        for (; i + Lanes::width <= n; i += Lanes::width) {
+            const Lanes centre = Lanes::load(curr + i);
+            if constexpr (Stencil::reads_prev) {
+                s(Lanes::load(curr + i - 1), centre, Lanes::load(curr + i + 1),
+                    Lanes::load(prev + i)).store(out + i);
+            }
+            else {
+                s(Lanes::load(curr + i - 1), centre, Lanes::load(curr + i + 1),
+                    centre).store(out + i);
+            }
+        }
+    }
+
+    // The weights are copied so that the stores through out cannot alias
+    // them and they stay in registers.
+    template <class Stencil>
+    void sweep_scalar(const Stencil& stencil, double* out, const double* curr,
+        const double* prev, std::size_t n)
+    {
+        const Stencil s = stencil;
+        tail(s, out, curr, prev, 0, n);
+    }
+
+#ifdef HEAT_X86
+    template <class Stencil>
+    HEAT_TARGET("sse2")
+    void sweep_sse2(const Stencil& stencil, double* out, const double* curr,
+        const double* prev, std::size_t n)
+    {
+        const Stencil s = stencil;
+        std::size_t i = 0;
+        packs<Sse2Lanes>(s, out, curr, prev, i, n);
+        tail(s, out, curr, prev, i, n);
+    }
+
+    template <class Stencil>
+    HEAT_TARGET("avx2")
+    void sweep_avx2(const Stencil& stencil, double* out, const double* curr,
+        const double* prev, std::size_t n)
+    {
+        const Stencil s = stencil;
+        std::size_t i = 0;
+        packs<Avx2Lanes>(s, out, curr, prev, i, n);
+        tail(s, out, curr, prev, i, n);
+    }
+
+    template <class Stencil>
+    HEAT_TARGET("avx512f")
+    void sweep_avx512(const Stencil& stencil, double* out, const double* curr,
+        const double* prev, std::size_t n)
+    {
+        const Stencil s = stencil;
+        std::size_t i = 0;
+        packs<Avx512Lanes>(s, out, curr, prev, i, n);
+        tail(s, out, curr, prev, i, n);
+    }
+#endif
+}
+
+// The sweep of Stencil for the instruction set of stencil_kernels()
+template <class Stencil>
+StencilSweep<Stencil> stencil_sweep()
+{
+    using namespace stencil_sweep_detail;
+    static const StencilSweep<Stencil> sweep = [] () -> StencilSweep<Stencil> {
+        switch (stencil_kernels().level) {
+#ifdef HEAT_X86
+        case SimdLevel::AVX512:
+            return sweep_avx512<Stencil>;
+        case SimdLevel::AVX2:
+            return sweep_avx2<Stencil>;
+        case SimdLevel::SSE2:
+            return sweep_sse2<Stencil>;
+#endif
+        default:
+            return sweep_scalar<Stencil>;
+        }
+    }();
+    return sweep;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "SimdLanes.h"
+
+// Stencil descriptors of the explicit schemes (see StencilSweep.h). The
+// expressions fix the order of the operations, and with it the rounding.
+// The weights are stored in Real: double for the schemes (the unprefixed
+// names), the level type of PrecisionSimulation, or a pack holding one
+// weight per wall in EnsembleSimulation.
+
+// l T_{i-1} + c T_i + r T_{i+1}: FTCS, the explicit half of Crank-Nicolson
+template <class Real>
+struct BasicThreePointStencil {
+    static constexpr bool reads_prev = false;
+    Real l, c, r;
+
+    template <class V>
+    HEAT_INLINE V operator()(const V& left, const V& centre, const V& right, const V& /*prev*/) const {
+        return V(l) * left + V(c) * centre + V(r) * right;
+    }
+};
+
+// T_i + r (T_{i-1} - 2 T_i + T_{i+1}): FTCS in update form
+template <class Real>
+struct BasicLaplacianUpdateStencil {
+    static constexpr bool reads_prev = false;
+    Real r;
+
+    template <class V>
+    HEAT_INLINE V operator()(const V& left, const V& centre, const V& right, const V& /*prev*/) const {
+        return centre + V(r) * (left - V(2.0) * centre + right);
+    }
+};
+
+// 2r (T_{i-1} - 2 T_i + T_{i+1}) + T^{n-1}_i: Richardson (CTCS)
+template <class Real>
+struct BasicRichardsonStencil {
+    static constexpr bool reads_prev = true;
+    Real two_r;
+
+    template <class V>
+    HEAT_INLINE V operator()(const V& left, const V& centre, const V& right, const V& prev) const {
+        return V(two_r) * (left - V(2.0) * centre + right) + prev;
+    }
+};
+
+// (a T^{n-1}_i + b (T_{i-1} + T_{i+1})) / denom: DuFort-Frankel with
+// a = 1 - 2r, b = 2r, denom = 1 + 2r
+template <class Real>
+struct BasicDuFortFrankelStencil {
+    static constexpr bool reads_prev = true;
+    Real a, b, denom;
+
+    template <class V>
+    HEAT_INLINE V operator()(const V& left, const V& /*centre*/, const V& right, const V& prev) const {
+        return (V(a) * prev + V(b) * (left + right)) / V(denom);
+    }
+};
+
+using ThreePointStencil = BasicThreePointStencil<double>;
+using LaplacianUpdateStencil = BasicLaplacianUpdateStencil<double>;
+using RichardsonStencil = BasicRichardsonStencil<double>;
+using DuFortFrankelStencil = BasicDuFortFrankelStencil<double>;
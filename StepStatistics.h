@@ -0,0 +1,8 @@
+#pragma once
+
+// Reductions over the interior nodes of a newly written time level n+1,
+// formed in the same pass as the level (see write_and_reduce)
+struct StepStatistics {
+    double max_change = 0.0;  // max |T^{n+1}_i - T^n_i|
+    double sum = 0.0;         // sum of T^{n+1}_i
+};
@@ -0,0 +1,188 @@
+#include "StreamingSimulation.h"
+#include "Grid1D.h"
+#include "SchemeMethods.h"
+#include "StencilSweep.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    std::size_t checked_size(const HeatProblem& problem)
+    {
+        const Grid1D& grid = problem.grid();
+        if (!problem.constant_coefficients()) {
+            throw std::runtime_error("StreamingSimulation: needs a uniform grid and a homogeneous wall");
+        }
+        if (grid.size() < 3) {
+            throw std::runtime_error("StreamingSimulation: grid too small (N < 3)");
+        }
+        return grid.size();
+    }
+}
+
+StreamingSimulation::StreamingSimulation(const HeatProblem& problem,
+    const std::string& scheme_name,
+    double dt, double t_end,
+    const std::string& level_files,
+    const TemporalBlocking& chunking)
+    : problem_(problem),
+    scheme_name_(scheme_name),
+    dt_(dt),
+    t_end_(t_end),
+    chunking_(chunking),
+    level_a_(level_files + "_0.bin", checked_size(problem)),
+    level_b_(level_files + "_1.bin", checked_size(problem)),
+    curr_(level_a_.data()),
+    prev_(level_b_.data())
+{
+    bool is_explicit = false;
+    visit_method(scheme_name, [&](auto method) {
+        is_explicit = !is_theta_method<decltype(method)>::value;
+    });
+    if (!is_explicit) {
+        throw std::runtime_error("StreamingSimulation: '" + scheme_name
+            + "' is not an explicit scheme");
+    }
+
+    const double dx = problem.grid().dx();
+    r_ = problem.diffusivity() * dt / (dx * dx);
+
+    level_a_.advise_sequential();
+    level_b_.advise_sequential();
+}
+
+double StreamingSimulation::run_to_end()
+{
+    const std::size_t N = size();
+    curr_ = level_a_.data();
+    prev_ = level_b_.data();
+
+    // Initial condition at t = 0 in both levels
+    std::fill(curr_, curr_ + N, problem_.Tin());
+    std::fill(prev_, prev_ + N, problem_.Tin());
+
+    int n_steps = static_cast<int>(std::round(t_end_ / dt_));
+    double t = 0.0;
+    if (n_steps <= 0) {
+        return t;
+    }
+
+    visit_method(scheme_name_, [&](auto method) {
+        using Method = decltype(method);
+        if constexpr (!is_theta_method<Method>::value) {
+            march<Method>(static_cast<std::size_t>(n_steps));
+        }
+    });
+
+    for (int n = 0; n < n_steps; ++n) {
+        t += dt_;
+    }
+    return t;
+}
+
+template <class Method>
+void StreamingSimulation::march(std::size_t n_steps)
+{
+    // Level 1 goes into the storage of the copy of level 0
+    first_step<Method>();
+    std::swap(curr_, prev_);
+    const std::size_t remaining = n_steps - 1;
+
+    const auto stencil = Method::stencil(r_);
+    const auto sweep = stencil_sweep<decltype(stencil)>();
+    advance_tiled(curr_, prev_, size(), remaining, chunking_,
+        [&stencil, sweep](double* next, const double* curr, const double* prev, std::size_t n) {
+            sweep(stencil, next, curr, prev, n);
+        },
+        [this](std::size_t lo, std::size_t hi) { before_chunk(lo, hi); });
+}
+
+template <class Method>
+void StreamingSimulation::first_step()
+{
+    // Same start-up step as ExplicitScheme<Method>; for a two-level method
+    // an ordinary step, unblocked because it sets the walls
+    const std::size_t N = size();
+    const std::size_t tile = std::max<std::size_t>(chunking_.tile_size, 1);
+    const double Tsur = problem_.Tsur();
+    const double* curr = curr_;
+    double* next = prev_;
+    const auto stencil = [this] {
+        if constexpr (Method::start_up == StartUp::None) {
+            return Method::stencil(r_);
+        }
+        else {
+            return Method::start_up_stencil(r_);
+        }
+    }();
+    static_assert(!decltype(stencil)::reads_prev, "StreamingSimulation: two-level first step");
+    const auto sweep = stencil_sweep<decltype(stencil)>();
+
+    // StartUp::FirstStep: Tsur is the outer neighbour of the wall-adjacent
+    // nodes, which are done last
+    const bool walls = (Method::start_up == StartUp::FirstStep);
+    const std::size_t first = walls ? 2 : 1;
+    const std::size_t last = walls ? N - 2 : N - 1;
+
+    for (std::size_t lo = 1; lo < N - 1; lo += tile) {
+        const std::size_t hi = std::min(lo + tile, N - 1);
+        before_chunk(lo, hi);
+
+        const std::size_t begin = std::max(lo, first);
+        const std::size_t end = std::min(hi, last);
+        if (begin < end) {
+            sweep(stencil, next + begin, curr + begin, nullptr, end - begin);
+        }
+    }
+    if (walls) {
+        next[1] = stencil(Tsur, curr[1], N > 3 ? curr[2] : Tsur, curr[1]);
+        next[N - 2] = stencil(N > 3 ? curr[N - 3] : Tsur, curr[N - 2], Tsur, curr[N - 2]);
+    }
+
+    next[0] = Tsur;
+    next[N - 1] = Tsur;
+}
+
+void StreamingSimulation::before_chunk(std::size_t lo, std::size_t hi)
+{
+    // Chunks are visited left to right; all but the last have tile_size
+    // nodes, and the one just finished is [lo - tile_size, lo)
+    const std::size_t tile = std::max<std::size_t>(chunking_.tile_size, 1);
+    const std::size_t ahead = tile + 2 * chunking_.steps_per_tile;
+    for (MappedArray* level : { &level_a_, &level_b_ }) {
+        level->prefetch(hi, ahead);
+        if (lo > 1) {
+            level->write_back(lo - tile, tile);
+        }
+    }
+}
+
+std::size_t StreamingSimulation::size() const
+{
+    return level_a_.size();
+}
+
+const double* StreamingSimulation::solution() const
+{
+    return curr_;
+}
+
+void StreamingSimulation::sample(std::size_t stride, std::vector<double>& x,
+    std::vector<double>& T) const
+{
+    const Grid1D& grid = problem_.grid();
+    const std::size_t N = size();
+    stride = std::max<std::size_t>(stride, 1);
+
+    x.clear();
+    T.clear();
+    for (std::size_t i = 0; i < N; i += stride) {
+        x.push_back(grid.x(i));
+        T.push_back(curr_[i]);
+    }
+    if ((N - 1) % stride != 0) {
+        x.push_back(grid.x(N - 1));
+        T.push_back(curr_[N - 1]);
+    }
+}
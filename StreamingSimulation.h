@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "HeatProblem.h"
+#include "MappedArray.h"
+#include "TemporalBlocking.h"
+
+// Out-of-core run of an explicit scheme (any ExplicitScheme method of
+// SchemeMethods.h: Richardson, DuFortFrankel, FTCS) on a uniform grid and a
+// homogeneous wall, for grids larger than RAM. Levels n and n-1 live in two memory-mapped files
+// (level_files + "_0.bin" and "_1.bin", removed afterwards) and the march
+// streams through them with advance_tiled: chunks of chunking.tile_size
+// nodes are read, advanced chunking.steps_per_tile steps in memory and
+// written back in place, so one pass over the files (32 bytes per node)
+// covers that many steps. The next chunk is prefetched and finished chunks
+// are handed to write-back as the pass moves on, so the disk sees two
+// sequential streams. Memory use depends on the chunk size only.
+//
+// Results are identical to Simulation with the same scheme.
+class StreamingSimulation {
+public:
+    StreamingSimulation(const HeatProblem& problem,
+        const std::string& scheme_name,
+        double dt, double t_end,
+        const std::string& level_files,
+        const TemporalBlocking& chunking = TemporalBlocking{ std::size_t(1) << 20, 64 });
+
+    // Marches from the initial condition to t_end; returns the time reached
+    double run_to_end();
+
+    std::size_t size() const;
+
+    // Level n after run_to_end() (size() values, in the mapped file)
+    const double* solution() const;
+
+    // Nodes 0, stride, 2 stride, ... and the last one, with their
+    // coordinates
+    void sample(std::size_t stride, std::vector<double>& x,
+        std::vector<double>& T) const;
+
+private:
+    // n_steps > 0 steps from the initial condition, start-up step included
+    template <class Method>
+    void march(std::size_t n_steps);
+
+    // First step from curr_ into prev_ (not blocked)
+    template <class Method>
+    void first_step();
+
+    // Prefetch of the next chunk and write-back of the finished one
+    void before_chunk(std::size_t lo, std::size_t hi);
+
+    const HeatProblem& problem_;
+    std::string scheme_name_;
+    double dt_;
+    double t_end_;
+    double r_;
+    TemporalBlocking chunking_;
+    MappedArray level_a_;
+    MappedArray level_b_;
+    double* curr_;
+    double* prev_;
+};
@@ -0,0 +1,282 @@
+#include "SubdomainSimulation.h"
+#include "Grid1D.h"
+#include "SchemeMethods.h"
+#include "StencilSweep.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+SubdomainSimulation::SubdomainSimulation(const HeatProblem& problem,
+    const std::string& scheme_name,
+    double dt, double t_end,
+    Transport& transport)
+    : problem_(problem),
+    transport_(transport),
+    scheme_name_(scheme_name),
+    dt_(dt),
+    t_end_(t_end),
+    rank_(transport.rank()),
+    n_ranks_(transport.size()),
+    n_rows_(problem.grid().size() >= 2 ? problem.grid().size() - 2 : 0),
+    rows_(0),
+    levels_(0)
+{
+    const Grid1D& grid = problem.grid();
+    if (!problem.constant_coefficients()) {
+        throw std::runtime_error("SubdomainSimulation: needs a uniform grid and a homogeneous wall");
+    }
+    // Two rows per rank keep a non-empty block after the separator
+    if (n_rows_ < 2 * n_ranks_) {
+        throw std::runtime_error("SubdomainSimulation: too many ranks for the grid");
+    }
+
+    const double dx = grid.dx();
+    r_ = problem.diffusivity() * dt / (dx * dx);
+    Tsur_ = problem.Tsur();
+
+    rows_ = row_begin(rank_ + 1) - row_begin(rank_);
+    levels_ = TimeLevels(rows_ + 2);
+
+    const bool known = visit_method(scheme_name, [&](auto method) {
+        using Method = decltype(method);
+        if constexpr (is_theta_method<Method>::value) {
+            factor(Method::theta);
+        }
+    });
+    if (!known) {
+        throw std::runtime_error("SubdomainSimulation: unknown scheme '" + scheme_name + "'");
+    }
+}
+
+std::size_t SubdomainSimulation::row_begin(std::size_t k) const
+{
+    return k * n_rows_ / n_ranks_;
+}
+
+std::size_t SubdomainSimulation::first_node() const
+{
+    return row_begin(rank_) + 1;
+}
+
+std::size_t SubdomainSimulation::node_count() const
+{
+    return rows_;
+}
+
+void SubdomainSimulation::factor(double theta)
+{
+    const double a = theta * r_;
+    a_ = c_ = -a;
+    b_ = 1.0 + 2.0 * a;
+
+    // Row 0 of every rank but rank 0 is a separator
+    const std::size_t s = (rank_ > 0) ? 1 : 0;
+    block_.factor(a_, b_, c_, rows_ - s);
+    if (n_ranks_ == 1) {
+        return;
+    }
+
+    left_spike_.assign(rows_, 0.0);
+    right_spike_.assign(rows_, 0.0);
+    if (rank_ > 0) {
+        left_spike_[s] = -a_;
+        block_.solve(left_spike_.data() + s);
+    }
+    if (rank_ + 1 < n_ranks_) {
+        right_spike_[rows_ - 1] = -c_;
+        block_.solve(right_spike_.data() + s);
+    }
+
+    // Spike ends to rank 0, which assembles the separator system once
+    const double ends[4] = { left_spike_[s], left_spike_[rows_ - 1],
+        right_spike_[s], right_spike_[rows_ - 1] };
+    transport_.send(0, ends, 4);
+    if (rank_ != 0) {
+        return;
+    }
+
+    std::vector<double> all(4 * n_ranks_);
+    for (std::size_t k = 0; k < n_ranks_; ++k) {
+        transport_.receive(k, &all[4 * k], 4);
+    }
+    // Separator j (first row of rank j) couples to the last row of rank
+    // j - 1 and the first row of rank j
+    const std::size_t n_sep = n_ranks_ - 1;
+    std::vector<double> sub(n_sep), diag(n_sep), super(n_sep);
+    for (std::size_t j = 1; j <= n_sep; ++j) {
+        const double* before = &all[4 * (j - 1)];
+        const double* after = &all[4 * j];
+        sub[j - 1] = a_ * before[1];
+        diag[j - 1] = b_ + a_ * before[3] + c_ * after[0];
+        super[j - 1] = c_ * after[2];
+    }
+    reduced_.factor(sub.data(), diag.data(), super.data(), n_sep);
+    separators_.resize(n_sep);
+    exchange_.resize(3 * n_ranks_);
+}
+
+double SubdomainSimulation::run_to_end()
+{
+    std::vector<double>& T0 = levels_.curr();
+    std::fill(T0.begin(), T0.end(), problem_.Tin());
+    levels_.prev() = T0;
+
+    int n_steps = static_cast<int>(std::round(t_end_ / dt_));
+    double t = 0.0;
+
+    visit_method(scheme_name_, [&](auto method) {
+        for (int n = 0; n < n_steps; ++n) {
+            step<decltype(method)>(n == 0);
+            levels_.rotate();
+            t += dt_;
+        }
+    });
+    return t;
+}
+
+void SubdomainSimulation::exchange_halos(std::vector<double>& T)
+{
+    // The rings buffer the sends, so sending both sides first cannot
+    // deadlock
+    if (rank_ > 0) {
+        transport_.send(rank_ - 1, &T[1], 1);
+    }
+    if (rank_ + 1 < n_ranks_) {
+        transport_.send(rank_ + 1, &T[rows_], 1);
+    }
+    if (rank_ > 0) {
+        transport_.receive(rank_ - 1, &T[0], 1);
+    }
+    if (rank_ + 1 < n_ranks_) {
+        transport_.receive(rank_ + 1, &T[rows_ + 1], 1);
+    }
+}
+
+template <class Method>
+void SubdomainSimulation::step(bool first_step)
+{
+    std::vector<double>& T_curr = levels_.curr();
+    const std::vector<double>& T_prev = levels_.prev();
+    std::vector<double>& T_next = levels_.next();
+
+    const std::size_t m = rows_;
+    const double r = r_;
+    const double Tsur = Tsur_;
+    const bool left_wall = (rank_ == 0);
+    const bool right_wall = (rank_ + 1 == n_ranks_);
+
+    if (left_wall) T_next[0] = Tsur;
+    if (right_wall) T_next[m + 1] = Tsur;
+
+    if constexpr (is_theta_method<Method>::value) {
+        // Right-hand side as ThetaScheme; the fully implicit method needs
+        // no neighbours
+        constexpr double theta = Method::theta;
+        if constexpr (theta == 1.0) {
+            std::copy(T_curr.begin() + 1, T_curr.begin() + 1 + m, T_next.begin() + 1);
+        }
+        else {
+            exchange_halos(T_curr);
+            const double b = (1.0 - theta) * r;
+            stencil_sweep<ThreePointStencil>()(ThreePointStencil{ b, 1.0 - 2.0 * b, b },
+                T_next.data() + 1, T_curr.data() + 1, nullptr, m);
+        }
+        const double a = theta * r;
+        if (left_wall) T_next[1] += a * Tsur;
+        if (right_wall) T_next[m] += a * Tsur;
+        solve(T_next.data() + 1);
+    }
+    else {
+        exchange_halos(T_curr);
+        if constexpr (Method::start_up != StartUp::None) {
+            // Start-up step of ExplicitScheme<Method>
+            if (first_step) {
+                const auto s = Method::start_up_stencil(r);
+                stencil_sweep<decltype(s)>()(s, T_next.data() + 1, T_curr.data() + 1,
+                    nullptr, m);
+                if constexpr (Method::start_up == StartUp::FirstStep) {
+                    // Tsur as the outer neighbour of the wall-adjacent nodes
+                    if (left_wall) T_next[1] = s(Tsur, T_curr[1], T_curr[2], T_curr[1]);
+                    if (right_wall) T_next[m] = s(T_curr[m - 1], T_curr[m], Tsur, T_curr[m]);
+                }
+                return;
+            }
+        }
+        (void)first_step;
+        const auto s = Method::stencil(r);
+        stencil_sweep<decltype(s)>()(s, T_next.data() + 1, T_curr.data() + 1,
+            T_prev.data() + 1, m);
+    }
+}
+
+void SubdomainSimulation::solve(double* d)
+{
+    if (n_ranks_ == 1) {
+        block_.solve(d);
+        return;
+    }
+
+    // Local elimination: y = A_k^{-1} d_k on the rows after the separator
+    const std::size_t s = (rank_ > 0) ? 1 : 0;
+    block_.solve(d + s);
+
+    // Separator right-hand side and the two ends of y to rank 0, the two
+    // neighbouring separator values back
+    const double ends[3] = { s ? d[0] : 0.0, d[s], d[rows_ - 1] };
+    transport_.send(0, ends, 3);
+    if (rank_ == 0) {
+        solve_separators();
+    }
+    double x[2];
+    transport_.receive(0, x, 2);
+
+    // x_k = y_k + x_left g_k + x_right h_k
+    for (std::size_t i = s; i < rows_; ++i) {
+        d[i] += x[0] * left_spike_[i] + x[1] * right_spike_[i];
+    }
+    if (s) {
+        d[0] = x[0];
+    }
+}
+
+void SubdomainSimulation::solve_separators()
+{
+    for (std::size_t k = 0; k < n_ranks_; ++k) {
+        transport_.receive(k, &exchange_[3 * k], 3);
+    }
+    for (std::size_t j = 1; j < n_ranks_; ++j) {
+        separators_[j - 1] = exchange_[3 * j]
+            - a_ * exchange_[3 * (j - 1) + 2] - c_ * exchange_[3 * j + 1];
+    }
+    reduced_.solve(separators_.data());
+
+    for (std::size_t k = 0; k < n_ranks_; ++k) {
+        const double x[2] = { k > 0 ? separators_[k - 1] : 0.0,
+            k + 1 < n_ranks_ ? separators_[k] : 0.0 };
+        transport_.send(k, x, 2);
+    }
+}
+
+void SubdomainSimulation::gather(std::vector<double>& T)
+{
+    const std::vector<double>& local = levels_.curr();
+    const bool last = (rank_ + 1 == n_ranks_);
+
+    if (rank_ != 0) {
+        // The last rank also sends the right wall
+        transport_.send(0, local.data() + 1, rows_ + (last ? 1 : 0));
+        return;
+    }
+
+    T.resize(n_rows_ + 2);
+    std::copy(local.begin(), local.begin() + 1 + rows_, T.begin());
+    if (last) {
+        T.back() = local[rows_ + 1];
+        return;
+    }
+    for (std::size_t k = 1; k < n_ranks_; ++k) {
+        const std::size_t begin = row_begin(k);
+        const std::size_t count = row_begin(k + 1) - begin + (k + 1 == n_ranks_ ? 1 : 0);
+        transport_.receive(k, T.data() + begin + 1, count);
+    }
+}
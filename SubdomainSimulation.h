@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "HeatProblem.h"
+#include "TimeLevels.h"
+#include "Transport.h"
+#include "TridiagonalFactorization.h"
+
+// One rank's part of a domain-decomposed run. The interior nodes are split
+// evenly over transport.size() ranks; each rank keeps its own nodes plus
+// one halo (or wall) node on either side for levels n-1, n and n+1, and
+// swaps the halos of level n with its neighbours before every step.
+//
+// Any method of SchemeMethods.h runs from its descriptor. The explicit
+// methods update every node exactly as the single-process schemes do, so
+// the results are bit-identical. The theta methods solve the global system
+// with the partitioned algorithm of TridiagonalFactorization spread over
+// the ranks: the first row of every rank but rank 0 is a separator, each rank eliminates the rest of its
+// rows locally with two precomputed spikes, and rank 0 solves the small
+// separator system from three values per rank and sends two back. Those
+// results agree with the single-process run to round-off.
+// Uniform grids and homogeneous walls only.
+class SubdomainSimulation {
+public:
+    SubdomainSimulation(const HeatProblem& problem,
+        const std::string& scheme_name,
+        double dt, double t_end,
+        Transport& transport);
+
+    // Marches the local nodes to t_end; returns the time reached
+    double run_to_end();
+
+    // Collective. Rank 0 receives the whole profile in T; the other ranks
+    // send their nodes and leave T untouched.
+    void gather(std::vector<double>& T);
+
+    // Global index of the first owned node and the number of owned nodes
+    std::size_t first_node() const;
+    std::size_t node_count() const;
+
+private:
+    // Interior row range [begin, end) of rank k (node = row + 1)
+    std::size_t row_begin(std::size_t k) const;
+
+    void factor(double theta);
+    template <class Method>
+    void step(bool first_step);
+    void exchange_halos(std::vector<double>& T);
+    void solve(double* d);       // the local rows, in place
+    void solve_separators();     // rank 0
+
+    const HeatProblem& problem_;
+    Transport& transport_;
+    std::string scheme_name_;    // a method of SchemeMethods.h
+    double dt_;
+    double t_end_;
+    double r_;
+    double Tsur_;
+    std::size_t rank_;
+    std::size_t n_ranks_;
+    std::size_t n_rows_;         // interior rows of the whole grid
+    std::size_t rows_;           // local rows; local index i is row row_begin + i - 1
+    TimeLevels levels_;          // rows_ + 2 values per level
+
+    // Theta methods: A = tridiag(a_, b_, c_)
+    double a_ = 0.0, b_ = 0.0, c_ = 0.0;
+    TridiagonalFactorization block_;      // local rows after the separator
+    std::vector<double> left_spike_;      // response to the own separator
+    std::vector<double> right_spike_;     // response to the next separator
+    TridiagonalFactorization reduced_;    // rank 0: separator system
+    std::vector<double> separators_;      // rank 0: its right-hand side
+    std::vector<double> exchange_;        // rank 0: three values per rank
+};
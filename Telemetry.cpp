@@ -0,0 +1,170 @@
+#include "Telemetry.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+    constexpr std::size_t n_phases = static_cast<std::size_t>(TelemetryPhase::Count);
+
+    const char* const phase_names[n_phases] = {
+        "Simulation",
+        "SchemeStep",
+        "TridiagonalSolve",
+        "AnalyticalReference",
+        "Output",
+    };
+
+    struct PhaseCounters {
+        std::atomic<std::uint64_t> nanoseconds{ 0 };
+        std::atomic<std::uint64_t> calls{ 0 };
+        std::atomic<std::uint64_t> cells{ 0 };
+        std::atomic<std::uint64_t> bytes{ 0 };
+    };
+
+    PhaseCounters counters[n_phases];
+
+    // Open timers per phase on this thread
+    thread_local unsigned depth[n_phases] = {};
+
+    struct PhaseSnapshot {
+        double seconds;
+        std::uint64_t calls;
+        std::uint64_t cells;
+        std::uint64_t bytes;
+    };
+
+    PhaseSnapshot snapshot(std::size_t p)
+    {
+        return { 1e-9 * static_cast<double>(counters[p].nanoseconds.load()),
+            counters[p].calls.load(), counters[p].cells.load(),
+            counters[p].bytes.load() };
+    }
+
+    double per_second(double amount, double seconds)
+    {
+        return seconds > 0.0 ? amount / seconds : 0.0;
+    }
+}
+
+void Telemetry::record(TelemetryPhase phase, std::uint64_t nanoseconds,
+    std::uint64_t calls, std::uint64_t cells, std::uint64_t bytes)
+{
+    PhaseCounters& c = counters[static_cast<std::size_t>(phase)];
+    c.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    c.calls.fetch_add(calls, std::memory_order_relaxed);
+    c.cells.fetch_add(cells, std::memory_order_relaxed);
+    c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Telemetry::reset()
+{
+    for (PhaseCounters& c : counters) {
+        c.nanoseconds.store(0);
+        c.calls.store(0);
+        c.cells.store(0);
+        c.bytes.store(0);
+    }
+}
+
+std::size_t Telemetry::peak_memory_bytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<std::size_t>(pmc.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<std::size_t>(usage.ru_maxrss);         // bytes
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // kilobytes
+#endif
+#endif
+}
+
+void Telemetry::report_table(std::ostream& out)
+{
+    if (!enabled()) {
+        out << "Telemetry disabled (build with HEAT_ENABLE_TELEMETRY)\n";
+        return;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "phase                  time (s)      calls    Mcells/s      GB/s\n";
+    for (std::size_t p = 0; p < n_phases; ++p) {
+        PhaseSnapshot s = snapshot(p);
+        out << std::left << std::setw(20) << phase_names[p]
+            << std::right << std::fixed << std::setprecision(4)
+            << std::setw(11) << s.seconds
+            << std::setw(11) << s.calls
+            << std::setprecision(1)
+            << std::setw(12) << 1e-6 * per_second(static_cast<double>(s.cells), s.seconds)
+            << std::setprecision(2)
+            << std::setw(10) << 1e-9 * per_second(static_cast<double>(s.bytes), s.seconds)
+            << "\n";
+    }
+    out << "peak memory: " << std::setprecision(1)
+        << static_cast<double>(peak_memory_bytes()) / (1024.0 * 1024.0) << " MiB\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Telemetry::write_json(const std::string& filename)
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open output file: " + filename);
+    }
+
+    file << std::setprecision(9);
+    file << "{\n  \"enabled\": " << (enabled() ? "true" : "false") << ",\n"
+        << "  \"peak_memory_bytes\": " << peak_memory_bytes() << ",\n"
+        << "  \"phases\": [\n";
+    for (std::size_t p = 0; p < n_phases; ++p) {
+        PhaseSnapshot s = snapshot(p);
+        file << "    { \"name\": \"" << phase_names[p] << "\""
+            << ", \"seconds\": " << s.seconds
+            << ", \"calls\": " << s.calls
+            << ", \"cells\": " << s.cells
+            << ", \"bytes\": " << s.bytes
+            << ", \"cells_per_second\": " << per_second(static_cast<double>(s.cells), s.seconds)
+            << ", \"bytes_per_second\": " << per_second(static_cast<double>(s.bytes), s.seconds)
+            << " }" << (p + 1 < n_phases ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+}
+
+Telemetry::ScopedTimer::ScopedTimer(TelemetryPhase phase, std::uint64_t calls,
+    std::uint64_t cells, std::uint64_t bytes)
+    : phase_(phase),
+    outermost_(depth[static_cast<std::size_t>(phase)]++ == 0),
+    calls_(calls), cells_(cells), bytes_(bytes),
+    start_(std::chrono::steady_clock::now())
+{
+}
+
+Telemetry::ScopedTimer::~ScopedTimer()
+{
+    --depth[static_cast<std::size_t>(phase_)];
+    if (outermost_) {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        record(phase_, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            calls_, cells_, bytes_);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Run telemetry: per-phase call counts, wall time, cells and bytes.
+//
+// Instrumentation points use the macros below, which expand to nothing
+// unless the build defines HEAT_ENABLE_TELEMETRY, so a normal build carries
+// no trace of them. Counters are relaxed atomics, safe to update from the
+// thread pool. Times are inclusive (Simulation contains SchemeStep, which
+// contains TridiagonalSolve); a phase nested in itself on the same thread
+// is counted once, by its outermost scope.
+enum class TelemetryPhase {
+    Simulation,
+    SchemeStep,
+    TridiagonalSolve,
+    AnalyticalReference,
+    Output,
+    Count
+};
+
+class Telemetry {
+public:
+    static constexpr bool enabled() {
+#ifdef HEAT_ENABLE_TELEMETRY
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // calls: number of events (steps, solves, ...); cells: grid points
+    // processed; bytes: data moved (model values, or bytes written)
+    static void record(TelemetryPhase phase, std::uint64_t nanoseconds,
+        std::uint64_t calls, std::uint64_t cells, std::uint64_t bytes);
+
+    static void reset();
+
+    // Peak resident set size of the process in bytes (0 if unknown)
+    static std::size_t peak_memory_bytes();
+
+    static void report_table(std::ostream& out);
+    static void write_json(const std::string& filename);
+
+    // Times one scope; see HEAT_SCOPED_TIMER
+    class ScopedTimer {
+    public:
+        ScopedTimer(TelemetryPhase phase, std::uint64_t calls,
+            std::uint64_t cells, std::uint64_t bytes);
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        TelemetryPhase phase_;
+        bool outermost_;
+        std::uint64_t calls_;
+        std::uint64_t cells_;
+        std::uint64_t bytes_;
+        std::chrono::steady_clock::time_point start_;
+    };
+};
+
+#ifdef HEAT_ENABLE_TELEMETRY
+#define HEAT_TELEMETRY_CONCAT_(a, b) a##b
+#define HEAT_TELEMETRY_CONCAT(a, b) HEAT_TELEMETRY_CONCAT_(a, b)
+// Times the rest of the enclosing scope as `calls` events of `phase`
+#define HEAT_SCOPED_TIMER(phase, calls, cells, bytes)                       \
+    Telemetry::ScopedTimer HEAT_TELEMETRY_CONCAT(heat_timer_, __LINE__)(    \
+        TelemetryPhase::phase, (calls), (cells), (bytes))
+// Adds to the counters of `phase` without timing
+#define HEAT_COUNT(phase, calls, cells, bytes)                              \
+    Telemetry::record(TelemetryPhase::phase, 0, (calls), (cells), (bytes))
+#else
+// Arguments are not evaluated, only named (no unused-variable warnings)
+#define HEAT_TELEMETRY_UNUSED(calls, cells, bytes)                          \
+    ((void)sizeof(calls), (void)sizeof(cells), (void)sizeof(bytes))
+#define HEAT_SCOPED_TIMER(phase, calls, cells, bytes)                       \
+    HEAT_TELEMETRY_UNUSED(calls, cells, bytes)
+#define HEAT_COUNT(phase, calls, cells, bytes)                              \
+    HEAT_TELEMETRY_UNUSED(calls, cells, bytes)
+#endif
@@ -0,0 +1,197 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "SchemeBase.h"
+#include "DiffusionCoefficients.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "TridiagonalFactorization.h"
+#include "TridiagonalSolver.h"
+
+// Implicit theta-method generated from a method descriptor with
+//
+//     static constexpr double theta;  // in (0, 1]
+//
+//     (1 + 2 theta r) T^{n+1}_i - theta r (T^{n+1}_{i-1} + T^{n+1}_{i+1})
+//         = (1 - 2 (1 - theta) r) T^n_i + (1 - theta) r (T^n_{i-1} + T^n_{i+1})
+//
+// (theta = 1: Laasonen, 1/2: Crank-Nicolson). The matrix is factored once
+// per dt; with variable coefficients (non-uniform grid or composite wall)
+// its rows and the explicit weights come from DiffusionCoefficients and are
+// stored as arrays. A step forms the right-hand side row by row inside the
+// forward sweep of the solve and writes the solution straight into T_next
+// (TridiagonalFactorization::solve_rows); for theta = 1 the right-hand
+// side is T^n itself.
+//
+// Each method explicitly instantiates the scheme and its SchemeBase in its
+// own source file (see LaasonenScheme.cpp).
+template <class Method>
+class ThetaScheme : public SchemeBase<ThetaScheme<Method>> {
+public:
+    static constexpr double theta = Method::theta;
+    static_assert(theta > 0.0 && theta <= 1.0, "ThetaScheme: theta must lie in (0, 1]");
+
+    explicit ThetaScheme(const HeatProblem& problem);
+
+    void prepare(std::size_t N) override;
+
+private:
+    friend class SchemeBase<ThetaScheme>;
+
+    struct Coefficients {
+        std::size_t N;
+        double Tsur;
+        double l, c, r;            // explicit weights, constant coefficients
+        double bc_left, bc_right;  // weights of Tsur in the first/last row
+        const double* e_sub;       // explicit weights, variable coefficients
+        const double* e_diag;      // only (nullptr otherwise)
+        const double* e_super;
+    };
+
+    // Also (re-)factors the system matrix when dt changes
+    Coefficients coefficients(double dt);
+
+    void kernel(const Coefficients& coef,
+        const std::vector<double>& T_curr,
+        const std::vector<double>& T_prev,
+        std::vector<double>& T_next,
+        double t);
+
+    // factorized system matrix, rebuilt only when dt changes
+    TridiagonalFactorization factorization_;
+    double factored_dt_ = 0.0;  // 0 = not factored yet
+
+    // Variable coefficients (sized in prepare()): the matrix rows, and the
+    // explicit weights row by row unless theta = 1
+    std::vector<double> sub_, diag_, super_;
+    std::vector<double> e_sub_, e_diag_, e_super_;
+    DiffusionCoefficients weights_;
+};
+
+template <class Method>
+ThetaScheme<Method>::ThetaScheme(const HeatProblem& problem)
+    : SchemeBase<ThetaScheme>(problem) {
+}
+
+template <class Method>
+void ThetaScheme<Method>::prepare(std::size_t N)
+{
+    if (N < 3) {
+        throw std::runtime_error("ThetaScheme::prepare: grid too small (N < 3)");
+    }
+
+    factorization_.reserve(N - 2);
+    if (!this->problem_.constant_coefficients()) {
+        sub_.resize(N - 2);
+        diag_.resize(N - 2);
+        super_.resize(N - 2);
+        if (theta != 1.0) {
+            e_sub_.resize(N - 2);
+            e_diag_.resize(N - 2);
+            e_super_.resize(N - 2);
+        }
+    }
+}
+
+template <class Method>
+typename ThetaScheme<Method>::Coefficients ThetaScheme<Method>::coefficients(double dt)
+{
+    const HeatProblem& problem = this->problem_;
+    const Grid1D& grid = problem.grid();
+    std::size_t N = grid.size();
+
+    if (N < 3) {
+        throw std::runtime_error("ThetaScheme::step: grid too small (N < 3)");
+    }
+
+    std::size_t n_internal = N - 2; // unknowns: nodes 1..N-2
+
+    if (!problem.constant_coefficients()) {
+        // Row k is node k + 1: theta times the DiffusionCoefficients
+        // weights off the diagonal, 1 - theta of them on the right
+        if (dt != factored_dt_) {
+            weights_.update(problem, dt);
+            const double* left = weights_.left();
+            const double* right = weights_.right();
+            for (std::size_t k = 0; k < n_internal; ++k) {
+                sub_[k] = -(theta * left[k + 1]);
+                super_[k] = -(theta * right[k + 1]);
+                diag_[k] = 1.0 - sub_[k] - super_[k];
+            }
+            if (theta != 1.0) {
+                for (std::size_t k = 0; k < n_internal; ++k) {
+                    e_sub_[k] = (1.0 - theta) * left[k + 1];
+                    e_super_[k] = (1.0 - theta) * right[k + 1];
+                    e_diag_[k] = 1.0 - e_sub_[k] - e_super_[k];
+                }
+            }
+            factorization_.factor(sub_.data(), diag_.data(), super_.data(), n_internal,
+                TridiagonalSolver::partitions_for(n_internal));
+            factored_dt_ = dt;
+        }
+        return { N, problem.Tsur(), 0.0, 0.0, 0.0, -sub_.front(), -super_.back(),
+            e_sub_.data(), e_diag_.data(), e_super_.data() };
+    }
+
+    double dx = grid.dx();
+    double D = problem.diffusivity();
+    double r = D * dt / (dx * dx);
+
+    // Implicit and explicit off-diagonal weights
+    const double a = theta * r;
+    const double b = (1.0 - theta) * r;
+
+    // The system matrix depends on dt only: factor it once per dt
+    if (dt != factored_dt_) {
+        factorization_.factor(-a, 1.0 + 2.0 * a, -a, n_internal,
+            TridiagonalSolver::partitions_for(n_internal));
+        factored_dt_ = dt;
+    }
+
+    return { N, problem.Tsur(), b, 1.0 - 2.0 * b, b, a, a, nullptr, nullptr, nullptr };
+}
+
+template <class Method>
+inline void ThetaScheme<Method>::kernel(const Coefficients& coef,
+    const std::vector<double>& T_curr,
+    const std::vector<double>& /*T_prev*/,
+    std::vector<double>& T_next,
+    double /*t*/)
+{
+    const std::size_t N = coef.N;
+    const double Tsur = coef.Tsur;
+
+    // Solved into the interior of T_next; the right-hand side is formed
+    // row by row from T_curr (walls included) inside the solve
+    const double* curr = T_curr.data() + 1;
+    const double first = coef.bc_left * Tsur;
+    const double last = coef.bc_right * Tsur;
+
+    if constexpr (theta == 1.0) {
+        factorization_.solve_rows(T_next.data() + 1,
+            [curr](std::size_t i) { return curr[i]; }, first, last);
+    }
+    else {
+        if (coef.e_sub) {
+            const double* l = coef.e_sub;
+            const double* c = coef.e_diag;
+            const double* r = coef.e_super;
+            factorization_.solve_rows(T_next.data() + 1,
+                [curr, l, c, r](std::size_t i) {
+                    return l[i] * curr[i - 1] + c[i] * curr[i] + r[i] * curr[i + 1];
+                }, first, last);
+        }
+        else {
+            const double l = coef.l, c = coef.c, r = coef.r;
+            factorization_.solve_rows(T_next.data() + 1,
+                [curr, l, c, r](std::size_t i) {
+                    return l * curr[i - 1] + c * curr[i] + r * curr[i + 1];
+                }, first, last);
+        }
+    }
+
+    // Apply boundary conditions
+    T_next[0] = Tsur;
+    T_next[N - 1] = Tsur;
+}
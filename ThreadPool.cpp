@@ -0,0 +1,207 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+    // Pool and worker index of the current thread (null outside workers)
+    thread_local const void* tls_pool = nullptr;
+    thread_local std::size_t tls_index = 0;
+
+    // Shared between the caller of parallel_for and the helper tasks it
+    // queued; helpers that start late find no work left and return.
+    struct ParallelForState {
+        const std::function<void(std::size_t)>* body = nullptr;
+        std::size_t n_tasks = 0;
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error;
+
+        void drain() {
+            for (;;) {
+                std::size_t i = next.fetch_add(1);
+                if (i >= n_tasks) {
+                    return;
+                }
+                try {
+                    (*body)(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                if (done.fetch_add(1) + 1 == n_tasks) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    cv.notify_all();
+                }
+            }
+        }
+    };
+}
+
+ThreadPool::ThreadPool(std::size_t n_threads)
+{
+    n_threads = std::max<std::size_t>(n_threads, 1);
+    local_.reserve(n_threads);
+    for (std::size_t i = 0; i < n_threads; ++i) {
+        local_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(n_threads);
+    for (std::size_t i = 0; i < n_threads; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return workers_.size();
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> result = packaged->get_future();
+    push([packaged] { (*packaged)(); });
+    return result;
+}
+
+void ThreadPool::push(Task task)
+{
+    WorkerQueue& queue = (tls_pool == this) ? *local_[tls_index] : injector_;
+
+    // Counted before it becomes visible so the count never underflows
+    pending_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders the increment before a sleeper's re-check
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    cv_.notify_one();
+}
+
+bool ThreadPool::try_pop(std::size_t index, Task& task)
+{
+    // Own deque, newest first
+    {
+        WorkerQueue& own = *local_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // External submissions, in order
+    {
+        std::lock_guard<std::mutex> lock(injector_.mutex);
+        if (!injector_.tasks.empty()) {
+            task = std::move(injector_.tasks.front());
+            injector_.tasks.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Steal the oldest task of another worker
+    const std::size_t n = local_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        WorkerQueue& victim = *local_[(index + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::parallel_for(std::size_t n_tasks,
+    const std::function<void(std::size_t)>& body)
+{
+    if (n_tasks == 0) {
+        return;
+    }
+    if (n_tasks == 1) {
+        body(0);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->body = &body;
+    state->n_tasks = n_tasks;
+
+    // One helper per extra task, capped by the number of workers
+    std::size_t n_helpers = std::min(n_tasks - 1, workers_.size());
+    for (std::size_t h = 0; h < n_helpers; ++h) {
+        push([state] { state->drain(); });
+    }
+
+    state->drain();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done.load() == n_tasks; });
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+#ifndef _WIN32
+    // A child forked after the pool started inherits the object but none
+    // of its threads (and maybe a held queue lock): fail instead of hanging
+    static const pid_t owner = ::getpid();
+    if (::getpid() != owner) {
+        throw std::runtime_error("ThreadPool::shared: the pool was started before this process was forked");
+    }
+#endif
+    return pool;
+}
+
+void ThreadPool::worker_loop(std::size_t index)
+{
+    tls_pool = this;
+    tls_index = index;
+
+    for (;;) {
+        Task task;
+        if (try_pop(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        cv_.wait(lock, [this] { return stopping_ || pending_.load() > 0; });
+        if (stopping_ && pending_.load() == 0) {
+            return;
+        }
+    }
+}
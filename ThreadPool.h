@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size work-stealing pool.
+// Tasks submitted from outside go to a shared FIFO queue, so they start in
+// submission order. Tasks submitted from a worker go to that worker's own
+// deque; the owner runs them newest-first and idle workers steal the
+// oldest ones.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t n_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const;
+
+    std::future<void> submit(std::function<void()> task);
+
+    // Runs body(0), ..., body(n_tasks - 1) and returns when all are done.
+    // The calling thread executes tasks too, so this may be called from
+    // inside a pool task without deadlocking.
+    void parallel_for(std::size_t n_tasks,
+        const std::function<void(std::size_t)>& body);
+
+    // Process-wide pool with one thread per hardware thread. Throws in a
+    // process forked after the pool was started.
+    static ThreadPool& shared();
+
+private:
+    using Task = std::function<void()>;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task task);
+    bool try_pop(std::size_t index, Task& task);
+    void worker_loop(std::size_t index);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> local_;  // one per worker
+    WorkerQueue injector_;                             // external submits
+
+    std::atomic<std::size_t> pending_{ 0 };  // queued, not yet taken
+    std::mutex sleep_mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
@@ -0,0 +1,11 @@
+#include "TimeLevels.h"
+
+TimeLevels::TimeLevels(std::size_t N)
+{
+    for (auto& level : levels_)
+        level.resize(N);
+}
+
+std::size_t TimeLevels::size() const {
+    return levels_[0].size();
+}
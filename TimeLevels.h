@@ -0,0 +1,29 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Ring buffer holding the three time levels n-1, n and n+1.
+// Advancing in time rotates the ring instead of copying whole arrays.
+// The accessors are defined inline because they sit in the time loop.
+class TimeLevels {
+public:
+    explicit TimeLevels(std::size_t N);
+
+    std::size_t size() const;
+
+    std::vector<double>& prev() { return levels_[(head_ + 2) % 3]; }
+    std::vector<double>& curr() { return levels_[head_]; }
+    std::vector<double>& next() { return levels_[(head_ + 1) % 3]; }
+
+    const std::vector<double>& prev() const { return levels_[(head_ + 2) % 3]; }
+    const std::vector<double>& curr() const { return levels_[head_]; }
+    const std::vector<double>& next() const { return levels_[(head_ + 1) % 3]; }
+
+    // n-1 <- n, n <- n+1; the old n-1 storage is recycled as the new n+1
+    void rotate() { head_ = (head_ + 1) % 3; }
+
+private:
+    std::array<std::vector<double>, 3> levels_;
+    std::size_t head_ = 0;  // index of level n in levels_
+};
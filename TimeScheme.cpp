@@ -1,6 +1,72 @@
 #include "TimeScheme.h"
 #include "HeatProblem.h"
+#include "TimeLevels.h"
+#include "ObserverPipeline.h"
+#include "StencilKernels.h"
+#include "Telemetry.h"
+#include <stdexcept>
 
 TimeScheme::TimeScheme(const HeatProblem& problem)
     : problem_(problem) {
 }
+
+void TimeScheme::prepare(std::size_t /*N*/) {
+}
+
+void TimeScheme::advance(TimeLevels& levels, double& t, double dt,
+    std::size_t n_steps)
+{
+    HEAT_SCOPED_TIMER(SchemeStep, n_steps, levels.size() * n_steps, 0);
+
+    for (std::size_t n = 0; n < n_steps; ++n) {
+        step(levels.curr(), levels.prev(), levels.next(), t, dt);
+        levels.rotate();
+        t += dt;
+    }
+}
+
+std::size_t TimeScheme::advance_observed(TimeLevels& levels, double& t,
+    double dt, std::size_t n_steps, ObserverPipeline& observers)
+{
+    HEAT_SCOPED_TIMER(SchemeStep, n_steps, levels.size() * n_steps, 0);
+
+    const std::size_t n_internal = levels.size() > 2 ? levels.size() - 2 : 0;
+    for (std::size_t n = 0; n < n_steps; ++n) {
+        step(levels.curr(), levels.prev(), levels.next(), t, dt);
+
+        StepStatistics stats;
+        write_and_reduce(levels.next().data() + 1, levels.curr().data() + 1,
+            n_internal, stats, [](std::size_t, std::size_t) {});
+
+        levels.rotate();
+        t += dt;
+        if (!observers.after_step(t, levels.curr(), stats)) {
+            return n + 1;
+        }
+    }
+    return n_steps;
+}
+
+bool TimeScheme::step_blocked(std::vector<double>& /*T_curr*/,
+    std::vector<double>& /*T_prev*/,
+    double /*t*/, double /*dt*/, std::size_t /*n_steps*/,
+    const TemporalBlocking& /*blocking*/)
+{
+    return false;
+}
+
+void TimeScheme::save_state(std::vector<unsigned char>& state) const
+{
+    state.clear();
+}
+
+void TimeScheme::load_state(const std::vector<unsigned char>& state)
+{
+    if (!state.empty()) {
+        throw std::runtime_error("TimeScheme::load_state: unexpected scheme state");
+    }
+}
+
+void TimeScheme::reset_state()
+{
+}
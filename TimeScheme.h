@@ -1,22 +1,63 @@
 #pragma once
+#include <cstddef>
 #include <vector>
+#include "TemporalBlocking.h"
 
 class HeatProblem;
+class TimeLevels;
+class ObserverPipeline;
 
 class TimeScheme {
 public:
     explicit TimeScheme(const HeatProblem& problem);
     virtual ~TimeScheme() = default;
 
-    // T_curr: current time level
-    // T_prev: previous time level (or second previous for multi-level schemes)
+    // Called once with the grid size before time stepping starts.
+    // Schemes allocate their workspace here so that step() never allocates.
+    virtual void prepare(std::size_t N);
+
+    // T_curr: current time level n
+    // T_prev: previous time level n-1 (used by multi-level schemes)
+    // T_next: receives level n+1 (must not alias T_curr or T_prev)
     // t: current time
     // dt: time step
-    virtual void step(std::vector<double>& T_curr,
-        std::vector<double>& T_prev,
+    virtual void step(const std::vector<double>& T_curr,
+        const std::vector<double>& T_prev,
+        std::vector<double>& T_next,
         double t, double dt) = 0;
 
+    // Marches n_steps steps on the ring of time levels (rotating it after
+    // each step) and advances t accordingly. The default calls step() per
+    // step; the built-in schemes override it with a devirtualized loop
+    // (see SchemeBase).
+    virtual void advance(TimeLevels& levels, double& t, double dt,
+        std::size_t n_steps);
+
+    // Like advance(), but reduces every new level (StepStatistics) and
+    // hands it to observers after each step; stops early when they ask to.
+    // Returns the number of steps taken. The default reduces each level in
+    // a second pass; the explicit schemes reduce it while writing it.
+    virtual std::size_t advance_observed(TimeLevels& levels, double& t,
+        double dt, std::size_t n_steps, ObserverPipeline& observers);
+
+    // Advances n_steps steps in place on (T_curr, T_prev) with temporal
+    // blocking; on return they hold levels n + n_steps and n + n_steps - 1.
+    // Returns false (and does nothing) if the scheme has no blocked kernel
+    // in its current state; the caller then marches with step().
+    virtual bool step_blocked(std::vector<double>& T_curr,
+        std::vector<double>& T_prev,
+        double t, double dt, std::size_t n_steps,
+        const TemporalBlocking& blocking);
+
+    // Scheme-internal state beyond the time levels and t (such as a
+    // start-up flag), saved in checkpoints. The default has none.
+    virtual void save_state(std::vector<unsigned char>& state) const;
+    virtual void load_state(const std::vector<unsigned char>& state);
+
+    // Puts that state back to the one of a new scheme; called at the start
+    // of every run from the initial condition. The default has none.
+    virtual void reset_state();
+
 protected:
     const HeatProblem& problem_;
 };
-
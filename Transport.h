@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+
+// Point-to-point messages between the ranks of a domain-decomposed run
+// (see SubdomainSimulation). Messages from one rank to another arrive in
+// the order they were sent; send() may return before the peer receives.
+// Implementations: SharedMemoryTransport (processes on one machine).
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    virtual std::size_t rank() const = 0;
+    virtual std::size_t size() const = 0;
+
+    virtual void send(std::size_t to, const double* data, std::size_t count) = 0;
+    virtual void receive(std::size_t from, double* data, std::size_t count) = 0;
+};
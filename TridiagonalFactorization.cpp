@@ -0,0 +1,257 @@
+#include "TridiagonalFactorization.h"
+#include "ThreadPool.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    template <class Real>
+    struct ConstantCoefficients {
+        Real a, b, c;
+        Real sub(std::size_t) const { return a; }
+        Real diag(std::size_t) const { return b; }
+        Real super(std::size_t) const { return c; }
+    };
+
+    template <class Real>
+    struct RowCoefficients {
+        const Real* a;
+        const Real* b;
+        const Real* c;
+        Real sub(std::size_t i) const { return a[i]; }
+        Real diag(std::size_t i) const { return b[i]; }
+        Real super(std::size_t i) const { return c[i]; }
+    };
+
+    template <class Real>
+    void check_pivot(Real beta)
+    {
+        if (beta == 0) {
+            throw std::runtime_error("TridiagonalFactorization::factor: zero pivot");
+        }
+    }
+}
+
+template <class Real>
+void BasicTridiagonalFactorization<Real>::reserve(std::size_t n)
+{
+    c_prime_.reserve(n);
+    inv_pivot_.reserve(n);
+}
+
+template <class Real>
+void BasicTridiagonalFactorization<Real>::factor(Real a, Real b, Real c,
+    std::size_t n, std::size_t n_partitions)
+{
+    a_ = a;
+    sub_.clear();
+    factor_rows(ConstantCoefficients<Real>{ a, b, c }, n, n_partitions);
+}
+
+template <class Real>
+void BasicTridiagonalFactorization<Real>::factor(const Real* a, const Real* b,
+    const Real* c, std::size_t n, std::size_t n_partitions)
+{
+    sub_.assign(a, a + n);
+    factor_rows(RowCoefficients<Real>{ a, b, c }, n, n_partitions);
+}
+
+template <class Real>
+template <class Coefficients>
+void BasicTridiagonalFactorization<Real>::factor_rows(const Coefficients& coef,
+    std::size_t n, std::size_t n_partitions)
+{
+    c_prime_.resize(n);
+    inv_pivot_.resize(n);
+    block_begin_.clear();
+
+    // Every block keeps at least two rows
+    n_partitions = std::min(n_partitions, (n + 1) / 3);
+
+    if (n_partitions <= 1) {
+        if (n == 0) {
+            return;
+        }
+        check_pivot(coef.diag(0));
+        inv_pivot_[0] = Real(1) / coef.diag(0);
+        c_prime_[0] = coef.super(0) * inv_pivot_[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            Real beta = coef.diag(i) - coef.sub(i) * c_prime_[i - 1];
+            check_pivot(beta);
+            inv_pivot_[i] = Real(1) / beta;
+            c_prime_[i] = coef.super(i) * inv_pivot_[i];
+        }
+        c_prime_[n - 1] = 0;  // last row has no super-diagonal
+        return;
+    }
+
+    // Split the non-separator rows as evenly as possible
+    const std::size_t P = n_partitions;
+    const std::size_t block_rows = n - (P - 1);
+    block_begin_.resize(P + 1);
+    std::size_t row = 0;
+    for (std::size_t k = 0; k < P; ++k) {
+        block_begin_[k] = row;
+        row += block_rows / P + (k < block_rows % P ? 1 : 0) + 1;
+    }
+    block_begin_[P] = row;  // == n + 1
+
+    left_spike_.assign(n, Real(0));
+    right_spike_.assign(n, Real(0));
+
+    // Factor each block independently; its couplings to the separators
+    // become the right-hand sides of the two spikes.
+    auto factor_block = [&](std::size_t k) {
+        const std::size_t lo = block_begin_[k];
+        const std::size_t hi = block_begin_[k + 1] - 1;
+
+        check_pivot(coef.diag(lo));
+        inv_pivot_[lo] = Real(1) / coef.diag(lo);
+        c_prime_[lo] = coef.super(lo) * inv_pivot_[lo];
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            Real beta = coef.diag(i) - coef.sub(i) * c_prime_[i - 1];
+            check_pivot(beta);
+            inv_pivot_[i] = Real(1) / beta;
+            c_prime_[i] = coef.super(i) * inv_pivot_[i];
+        }
+        c_prime_[hi - 1] = 0;
+
+        if (k > 0) {
+            left_spike_[lo] = -coef.sub(lo);
+            solve_block(left_spike_.data(), lo, hi);
+        }
+        if (k + 1 < P) {
+            right_spike_[hi - 1] = -coef.super(hi - 1);
+            solve_block(right_spike_.data(), lo, hi);
+        }
+    };
+    ThreadPool::shared().parallel_for(P, factor_block);
+
+    // Reduced system for the P - 1 separator values
+    const std::size_t n_sep = P - 1;
+    sep_a_.resize(n_sep);
+    sep_c_.resize(n_sep);
+    red_sub_.resize(n_sep);
+    red_c_prime_.resize(n_sep);
+    red_inv_pivot_.resize(n_sep);
+
+    std::vector<Real> red_diag(n_sep), red_super(n_sep);
+    for (std::size_t j = 0; j < n_sep; ++j) {
+        const std::size_t s = block_begin_[j + 1] - 1;
+        sep_a_[j] = coef.sub(s);
+        sep_c_[j] = coef.super(s);
+        red_sub_[j] = sep_a_[j] * left_spike_[s - 1];
+        red_diag[j] = coef.diag(s) + sep_a_[j] * right_spike_[s - 1]
+            + sep_c_[j] * left_spike_[s + 1];
+        red_super[j] = sep_c_[j] * right_spike_[s + 1];
+    }
+
+    check_pivot(red_diag[0]);
+    red_inv_pivot_[0] = Real(1) / red_diag[0];
+    red_c_prime_[0] = red_super[0] * red_inv_pivot_[0];
+    for (std::size_t j = 1; j < n_sep; ++j) {
+        Real beta = red_diag[j] - red_sub_[j] * red_c_prime_[j - 1];
+        check_pivot(beta);
+        red_inv_pivot_[j] = Real(1) / beta;
+        red_c_prime_[j] = red_super[j] * red_inv_pivot_[j];
+    }
+}
+
+template <class Real>
+void BasicTridiagonalFactorization<Real>::solve_block(Real* d,
+    std::size_t lo, std::size_t hi) const
+{
+    const Real* c_prime = c_prime_.data();
+    const Real* inv_pivot = inv_pivot_.data();
+
+    // Forward sweep
+    d[lo] *= inv_pivot[lo];
+    if (sub_.empty()) {
+        const Real a = a_;
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            d[i] = (d[i] - a * d[i - 1]) * inv_pivot[i];
+        }
+    }
+    else {
+        const Real* a = sub_.data();
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            d[i] = (d[i] - a[i] * d[i - 1]) * inv_pivot[i];
+        }
+    }
+
+    // Back substitution
+    for (std::size_t i = hi - 1; i-- > lo; ) {
+        d[i] -= c_prime[i] * d[i + 1];
+    }
+}
+
+template <class Real>
+void BasicTridiagonalFactorization<Real>::solve(Real* d) const
+{
+    const std::size_t n = c_prime_.size();
+    if (n == 0) {
+        return;
+    }
+
+    // Forward: reads d, inverse pivots (and the sub-diagonal if row-wise),
+    // writes d; backward: reads c', updates d
+    HEAT_SCOPED_TIMER(TridiagonalSolve, 1, n, 7 * sizeof(Real) * n);
+
+    if (block_begin_.empty()) {
+        solve_block(d, 0, n);
+        return;
+    }
+
+    const std::size_t P = block_begin_.size() - 1;
+    const std::size_t n_sep = P - 1;
+    ThreadPool& pool = ThreadPool::shared();
+
+    // 1) Independent block solves: d <- y = A_k^{-1} d_k
+    pool.parallel_for(P, [&](std::size_t k) {
+        solve_block(d, block_begin_[k], block_begin_[k + 1] - 1);
+    });
+
+    // 2) Reduced system, solved in place in the separator rows
+    for (std::size_t j = 0; j < n_sep; ++j) {
+        const std::size_t s = block_begin_[j + 1] - 1;
+        d[s] -= sep_a_[j] * d[s - 1] + sep_c_[j] * d[s + 1];
+    }
+    std::size_t s_prev = block_begin_[1] - 1;
+    d[s_prev] *= red_inv_pivot_[0];
+    for (std::size_t j = 1; j < n_sep; ++j) {
+        const std::size_t s = block_begin_[j + 1] - 1;
+        d[s] = (d[s] - red_sub_[j] * d[s_prev]) * red_inv_pivot_[j];
+        s_prev = s;
+    }
+    for (std::size_t j = n_sep - 1; j-- > 0; ) {
+        const std::size_t s = block_begin_[j + 1] - 1;
+        d[s] -= red_c_prime_[j] * d[block_begin_[j + 2] - 1];
+    }
+
+    // 3) Spike correction: x_k = y_k + x_left * g_k + x_right * h_k
+    pool.parallel_for(P, [&](std::size_t k) {
+        const std::size_t lo = block_begin_[k];
+        const std::size_t hi = block_begin_[k + 1] - 1;
+        const Real x_left = (k > 0) ? d[lo - 1] : Real(0);
+        const Real x_right = (k + 1 < P) ? d[hi] : Real(0);
+        const Real* g = left_spike_.data();
+        const Real* h = right_spike_.data();
+        for (std::size_t i = lo; i < hi; ++i) {
+            d[i] += x_left * g[i] + x_right * h[i];
+        }
+    });
+}
+
+template <class Real>
+std::size_t BasicTridiagonalFactorization<Real>::size() const {
+    return c_prime_.size();
+}
+
+template <class Real>
+std::size_t BasicTridiagonalFactorization<Real>::partitions() const {
+    return block_begin_.empty() ? 1 : block_begin_.size() - 1;
+}
+
+template class BasicTridiagonalFactorization<float>;
+template class BasicTridiagonalFactorization<double>;
+template class BasicTridiagonalFactorization<long double>;
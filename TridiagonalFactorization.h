@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Telemetry.h"
+
+// Thomas factorization of a tri-diagonal matrix with sub-diagonal a, main
+// diagonal b and super-diagonal c (n rows), stored and solved in Real
+// (float, double or long double; TridiagonalFactorization is the double
+// version used by the schemes).
+// The modified super-diagonal and the reciprocal pivots are computed once by
+// factor(); solve() then costs one forward and one backward sweep, in place
+// and without divisions or allocations.
+//
+// With n_partitions > 1 the rows are split into blocks separated by single
+// separator rows. Each block is factored on its own together with its two
+// spikes (the block's response to the neighbouring separator values), so a
+// solve runs the blocks in parallel on ThreadPool::shared(), solves the small
+// reduced system for the separators and applies the spike correction
+// (partitioned Thomas / SPIKE).
+template <class Real>
+class BasicTridiagonalFactorization {
+public:
+    // Pre-allocates storage for n rows so that factor() does not allocate.
+    void reserve(std::size_t n);
+
+    // Constant coefficients
+    void factor(Real a, Real b, Real c, std::size_t n,
+        std::size_t n_partitions = 1);
+
+    // Row-wise coefficients (a[0] and c[n-1] are not used)
+    void factor(const Real* a, const Real* b, const Real* c,
+        std::size_t n, std::size_t n_partitions = 1);
+
+    // Overwrites d[0..size()) with the solution of A x = d.
+    void solve(Real* d) const;
+
+    // Writes the solution of A x = d to x[0..size()), with d[i] = rhs(i)
+    // plus first / last added to rows 0 / size() - 1 (boundary terms).
+    // With a single partition the right-hand side is formed row by row in
+    // the forward sweep and never stored on its own; rhs must not read x.
+    template <class Rhs>
+    void solve_rows(Real* x, const Rhs& rhs, Real first, Real last) const;
+
+    std::size_t size() const;
+    std::size_t partitions() const;
+
+private:
+    template <class Coefficients>
+    void factor_rows(const Coefficients& coef, std::size_t n,
+        std::size_t n_partitions);
+
+    void solve_block(Real* d, std::size_t lo, std::size_t hi) const;
+
+    Real a_ = 0;
+    std::vector<Real> sub_;        // row-wise sub-diagonal (empty if constant)
+    std::vector<Real> c_prime_;    // modified super-diagonal
+    std::vector<Real> inv_pivot_;  // 1 / pivot of each row
+
+    // Partitioned solve (block_begin_ is empty for a single partition).
+    // Block k spans [block_begin_[k], block_begin_[k+1] - 1); the row in
+    // between two blocks is a separator. The last entry is n + 1.
+    std::vector<std::size_t> block_begin_;
+    std::vector<Real> left_spike_;   // response to the left separator
+    std::vector<Real> right_spike_;  // response to the right separator
+    std::vector<Real> sep_a_, sep_c_;  // off-diagonals of separator rows
+    std::vector<Real> red_sub_, red_c_prime_, red_inv_pivot_;  // reduced system
+};
+
+template <class Real>
+template <class Rhs>
+void BasicTridiagonalFactorization<Real>::solve_rows(Real* x, const Rhs& rhs,
+    Real first, Real last) const
+{
+    const std::size_t n = c_prime_.size();
+    if (n == 0) {
+        return;
+    }
+
+    if (!block_begin_.empty()) {
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = rhs(i);
+        }
+        x[0] += first;
+        x[n - 1] += last;
+        solve(x);
+        return;
+    }
+
+    HEAT_SCOPED_TIMER(TridiagonalSolve, 1, n, 7 * sizeof(Real) * n);
+
+    const Real* c_prime = c_prime_.data();
+    const Real* inv_pivot = inv_pivot_.data();
+
+    // Forward sweep on d = rhs + boundary terms, as in solve()
+    if (n == 1) {
+        x[0] = ((rhs(0) + first) + last) * inv_pivot[0];
+        return;
+    }
+    x[0] = (rhs(0) + first) * inv_pivot[0];
+    if (sub_.empty()) {
+        const Real a = a_;
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            x[i] = (rhs(i) - a * x[i - 1]) * inv_pivot[i];
+        }
+        x[n - 1] = ((rhs(n - 1) + last) - a * x[n - 2]) * inv_pivot[n - 1];
+    }
+    else {
+        const Real* a = sub_.data();
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            x[i] = (rhs(i) - a[i] * x[i - 1]) * inv_pivot[i];
+        }
+        x[n - 1] = ((rhs(n - 1) + last) - a[n - 1] * x[n - 2]) * inv_pivot[n - 1];
+    }
+
+    // Back substitution
+    for (std::size_t i = n - 1; i-- > 0; ) {
+        x[i] -= c_prime[i] * x[i + 1];
+    }
+}
+
+// Instantiated in TridiagonalFactorization.cpp
+extern template class BasicTridiagonalFactorization<float>;
+extern template class BasicTridiagonalFactorization<double>;
+extern template class BasicTridiagonalFactorization<long double>;
+
+using TridiagonalFactorization = BasicTridiagonalFactorization<double>;
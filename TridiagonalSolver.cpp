@@ -1,7 +1,21 @@
 #include "TridiagonalSolver.h"
+#include "TridiagonalFactorization.h"
+#include "ThreadPool.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <vector>
 
+namespace {
+    // Below this size the serial Thomas sweep beats the fork/join overhead
+    std::atomic<std::size_t> parallel_threshold_rows{ std::size_t(1) << 17 };
+    std::atomic<std::size_t> max_threads{ 0 };
+
+    // Smallest block worth handing to a thread
+    constexpr std::size_t min_rows_per_partition = 16384;
+}
+
 void TridiagonalSolver::solve(const std::vector<double>& a,
     const std::vector<double>& b,
     const std::vector<double>& c,
@@ -16,18 +30,44 @@ void TridiagonalSolver::solve(const std::vector<double>& a,
         return; // nothing to do
     }
 
-    // Temporary arrays for modified coefficients
+    // Reads a, b, c, d and writes c', d; then reads c' and updates d
+    HEAT_SCOPED_TIMER(TridiagonalSolve, 1, n, 72 * n);
+
+    std::size_t n_partitions = partitions_for(n);
+    if (n_partitions > 1) {
+        TridiagonalFactorization factorization;
+        factorization.factor(a.data(), b.data(), c.data(), n, n_partitions);
+        factorization.solve(d.data());
+        return;
+    }
+
+    // Temporary array for the modified super-diagonal
     std::vector<double> c_prime(n);
-    std::vector<double> d_prime(n);
 
-    // Forward sweep
+    solve(a.data(), b.data(), c.data(), d.data(), c_prime.data(), n);
+}
+
+void TridiagonalSolver::solve(const double* a,
+    const double* b,
+    const double* c,
+    double* d,
+    double* c_prime,
+    std::size_t n)
+{
+    if (n == 0) {
+        return; // nothing to do
+    }
+
+    HEAT_SCOPED_TIMER(TridiagonalSolve, 1, n, 72 * n);
+
+    // Forward sweep (d is overwritten with the modified right-hand side)
     double beta = b[0];
     if (beta == 0.0) {
         throw std::runtime_error("TridiagonalSolver::solve: zero pivot at row 0");
     }
 
     c_prime[0] = c[0] / beta;
-    d_prime[0] = d[0] / beta;
+    d[0] = d[0] / beta;
 
     for (std::size_t i = 1; i < n; ++i) {
         beta = b[i] - a[i] * c_prime[i - 1];
@@ -42,17 +82,38 @@ void TridiagonalSolver::solve(const std::vector<double>& a,
             c_prime[i] = c[i] / beta;
         }
 
-        d_prime[i] = (d[i] - a[i] * d_prime[i - 1]) / beta;
+        d[i] = (d[i] - a[i] * d[i - 1]) / beta;
     }
 
     // Back substitution
-    std::vector<double> x(n);
-    x[n - 1] = d_prime[n - 1];
-
     for (std::size_t i = n - 1; i-- > 0; ) {
-        x[i] = d_prime[i] - c_prime[i] * x[i + 1];
+        d[i] = d[i] - c_prime[i] * d[i + 1];
+    }
+}
+
+std::size_t TridiagonalSolver::partitions_for(std::size_t n)
+{
+    if (n < parallel_threshold_rows.load()) {
+        return 1;
+    }
+
+    std::size_t threads = ThreadPool::shared().size();
+    std::size_t cap = max_threads.load();
+    if (cap != 0) {
+        threads = std::min(threads, cap);
     }
 
-    // Copy solution back into d
-    d = x;
+    return std::max<std::size_t>(1, std::min(threads, n / min_rows_per_partition));
+}
+
+std::size_t TridiagonalSolver::parallel_threshold() {
+    return parallel_threshold_rows.load();
+}
+
+void TridiagonalSolver::set_parallel_threshold(std::size_t n_rows) {
+    parallel_threshold_rows.store(n_rows);
+}
+
+void TridiagonalSolver::set_max_threads(std::size_t n_threads) {
+    max_threads.store(n_threads);
 }
@@ -1,12 +1,32 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 
 class TridiagonalSolver {
 public:
     // Solves tri-diagonal system with coefficients a (sub), b (main), c (super)
     // On return, d holds the solution.
+    // Systems of at least parallel_threshold() rows are solved with the
+    // partitioned (multi-threaded) algorithm of TridiagonalFactorization.
     static void solve(const std::vector<double>& a,
         const std::vector<double>& b,
         const std::vector<double>& c,
         std::vector<double>& d);
-};
\ No newline at end of file
+
+    // Allocation-free serial variant: d[0..n) is overwritten with the
+    // solution, c_prime is caller-owned scratch of at least n values.
+    static void solve(const double* a,
+        const double* b,
+        const double* c,
+        double* d,
+        double* c_prime,
+        std::size_t n);
+
+    // Number of partitions to use for an n-row system: 1 below the
+    // threshold, otherwise one per thread (capped by set_max_threads()).
+    static std::size_t partitions_for(std::size_t n);
+
+    static std::size_t parallel_threshold();
+    static void set_parallel_threshold(std::size_t n_rows);
+    static void set_max_threads(std::size_t n_threads);  // 0 = all threads
+};
@@ -0,0 +1,367 @@
+// Cost per cell-step of the schemes, the tridiagonal solvers and the
+// analytical reference over a range of grid sizes.
+// Usage: BenchmarkSuite [--min-n N] [--max-n N] [--work CELL_STEPS]
+//                       [--json FILE] [--compare BASELINE.json] [--threshold FRACTION]
+//
+// Each case is timed over roughly CELL_STEPS cell-steps (default 5e7) after
+// one warm-up pass; the best of three runs is reported. Bandwidth is
+// effective: the bytes a straightforward implementation moves per cell
+// (listed per case below) divided by the time. Allocations are counted by
+// replacing the global operator new and reported per step (per call for the
+// solvers and the reference).
+//
+// --json writes the results; --compare reads a file written that way and
+// flags every case that got slower by more than the threshold (default
+// 0.10). The exit code is 1 if any case regressed.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "StencilKernels.h"
+#include "TimeLevels.h"
+#include "TridiagonalFactorization.h"
+#include "TridiagonalSolver.h"
+
+namespace {
+    std::atomic<std::size_t> allocation_count{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+    struct Result {
+        std::string name;
+        std::size_t n = 0;
+        double ns_per_cell = 0.0;
+        double gb_per_s = 0.0;
+        double allocs_per_step = 0.0;
+    };
+
+    struct Options {
+        std::size_t min_n = std::size_t(1) << 10;
+        std::size_t max_n = std::size_t(1) << 22;
+        double work = 5e7;
+        std::string json;
+        std::string compare;
+        double threshold = 0.10;
+    };
+
+    // Runs body(n_steps) three times after a warm-up and keeps the fastest;
+    // reset() is called before each run, outside the timing
+    template <class Body, class Reset>
+    Result measure(const std::string& name, std::size_t n, std::size_t n_steps,
+        double bytes_per_cell, Body body, Reset reset)
+    {
+        reset();
+        body(std::size_t(1));
+
+        double best = 1e300;
+        std::size_t allocs = 0;
+        for (int run = 0; run < 3; ++run) {
+            reset();
+            std::size_t before = allocation_count.load();
+            auto start = std::chrono::steady_clock::now();
+            body(n_steps);
+            auto stop = std::chrono::steady_clock::now();
+            allocs = allocation_count.load() - before;
+            best = std::min(best, std::chrono::duration<double>(stop - start).count());
+        }
+
+        const double cells = static_cast<double>(n) * static_cast<double>(n_steps);
+        Result r;
+        r.name = name;
+        r.n = n;
+        r.ns_per_cell = 1e9 * best / cells;
+        r.gb_per_s = bytes_per_cell * cells / best / 1e9;
+        r.allocs_per_step = static_cast<double>(allocs) / static_cast<double>(n_steps);
+        return r;
+    }
+
+    template <class Body>
+    Result measure(const std::string& name, std::size_t n, std::size_t n_steps,
+        double bytes_per_cell, Body body)
+    {
+        return measure(name, n, n_steps, bytes_per_cell, body, [] {});
+    }
+
+    // Bytes per cell-step: explicit schemes read levels n and n-1 and write
+    // n+1 (24); implicit schemes also assemble the right-hand side and run
+    // two sweeps over the factors (72).
+    void bench_schemes(std::size_t n, std::size_t n_steps, std::vector<Result>& out)
+    {
+        const double dx = 1.0 / static_cast<double>(n - 1);
+        Grid1D grid(1.0, dx);
+        // r = 0.1 for dt = 1e-4: DuFort-Frankel and the implicit schemes
+        // stay bounded. Richardson (CTCS) is unstable for every r > 0 and
+        // overflows to inf/NaN within the longer runs; its entry times the
+        // same stencil arithmetic past the blow-up (x86 handles inf and NaN
+        // at full speed), not a meaningful solution.
+        HeatProblem problem(grid, 0.1 * dx * dx / 1e-4, 38.0, 149.0);
+        const double dt = 1e-4;
+
+        const std::pair<const char*, double> schemes[] = {
+            { "Richardson", 24.0 },
+            { "DuFortFrankel", 24.0 },
+            { "Laasonen", 72.0 },
+            { "CrankNicolson", 72.0 },
+        };
+
+        for (const auto& entry : schemes) {
+            auto scheme = make_scheme(entry.first, problem);
+            scheme->prepare(grid.size());
+            TimeLevels levels(grid.size());
+            double t = 0.0;
+
+            // Every run starts from the initial condition
+            out.push_back(measure(entry.first, grid.size(), n_steps, entry.second,
+                [&](std::size_t steps) { scheme->advance(levels, t, dt, steps); },
+                [&] {
+                    problem.set_initial_condition(levels.curr());
+                    levels.prev() = levels.curr();
+                    scheme->reset_state();
+                    t = 0.0;
+                }));
+        }
+    }
+
+    // TridiagonalSolver (vector API; factors on every call): reads a, b, c,
+    // d and writes c', d forward, then reads c' and updates d (72 bytes).
+    // TridiagonalFactorization::solve: two sweeps over the stored factors
+    // and d (56 bytes).
+    void bench_solvers(std::size_t n, std::size_t n_calls, std::vector<Result>& out)
+    {
+        std::vector<double> a(n, -1.0), b(n, 4.0), c(n, -1.0), d(n, 1.0);
+        out.push_back(measure("TridiagonalSolver", n, n_calls, 72.0,
+            [&](std::size_t calls) {
+                for (std::size_t k = 0; k < calls; ++k) {
+                    TridiagonalSolver::solve(a, b, c, d);
+                }
+            }));
+
+        TridiagonalFactorization factorization;
+        factorization.factor(-1.0, 4.0, -1.0, n, TridiagonalSolver::partitions_for(n));
+        out.push_back(measure("TridiagonalFactorization", n, n_calls, 56.0,
+            [&](std::size_t calls) {
+                for (std::size_t k = 0; k < calls; ++k) {
+                    factorization.solve(d.data());
+                }
+            }));
+    }
+
+    // Reads x and writes T: 16 bytes per point; all 50 odd terms are used
+    void bench_analytical(std::size_t n, std::size_t n_calls, std::vector<Result>& out)
+    {
+        Grid1D grid(1.0, 1.0 / static_cast<double>(n - 1));
+        HeatProblem problem(grid, 1.0, 38.0, 149.0);
+        AnalyticalSolution analytical(problem, 100, 0.0);
+        std::vector<double> T(grid.size());
+
+        out.push_back(measure("AnalyticalSolution", grid.size(), n_calls, 16.0,
+            [&](std::size_t calls) {
+                for (std::size_t k = 0; k < calls; ++k) {
+                    analytical.evaluate(grid, 1e-6, T);
+                }
+            }));
+    }
+
+    std::string json_escape(const std::string& s)
+    {
+        std::string r;
+        for (char ch : s) {
+            if (ch == '"' || ch == '\\') {
+                r += '\\';
+            }
+            r += ch;
+        }
+        return r;
+    }
+
+    void write_json(const std::string& filename, const std::vector<Result>& results)
+    {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open output file: " + filename);
+        }
+        file << std::setprecision(6);
+        file << "{\n  \"isa\": \"" << stencil_kernels().isa << "\",\n"
+            << "  \"threads\": " << std::thread::hardware_concurrency() << ",\n"
+            << "  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            file << "    { \"name\": \"" << json_escape(r.name) << "\""
+                << ", \"n\": " << r.n
+                << ", \"ns_per_cell_step\": " << r.ns_per_cell
+                << ", \"gb_per_s\": " << r.gb_per_s
+                << ", \"allocs_per_step\": " << r.allocs_per_step
+                << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+    }
+
+    // Reads the "benchmarks" entries of a file written by write_json()
+    // (name, n and ns_per_cell_step only; any other keys are ignored).
+    std::map<std::pair<std::string, std::size_t>, double>
+        read_baseline(const std::string& filename)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open baseline: " + filename);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string text = buffer.str();
+
+        auto value_after = [&](std::size_t begin, std::size_t end,
+            const std::string& key) -> std::string {
+            std::size_t k = text.find("\"" + key + "\"", begin);
+            if (k == std::string::npos || k > end) {
+                return "";
+            }
+            std::size_t colon = text.find(':', k);
+            std::size_t v = text.find_first_not_of(" \t\n\r", colon + 1);
+            if (text[v] == '"') {
+                return text.substr(v + 1, text.find('"', v + 1) - v - 1);
+            }
+            return text.substr(v, text.find_first_of(",}\n", v) - v);
+        };
+
+        std::map<std::pair<std::string, std::size_t>, double> baseline;
+        std::size_t pos = text.find("\"benchmarks\"");
+        while (pos != std::string::npos) {
+            std::size_t begin = text.find('{', pos);
+            if (begin == std::string::npos) {
+                break;
+            }
+            std::size_t end = text.find('}', begin);
+            std::string name = value_after(begin, end, "name");
+            std::string n = value_after(begin, end, "n");
+            std::string ns = value_after(begin, end, "ns_per_cell_step");
+            if (!name.empty() && !n.empty() && !ns.empty()) {
+                baseline[{ name, std::stoull(n) }] = std::stod(ns);
+            }
+            pos = end;
+        }
+        return baseline;
+    }
+
+    Options parse(int argc, char** argv)
+    {
+        Options o;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                throw std::runtime_error("missing value for " + arg);
+            }
+            std::string value = argv[++i];
+            if (arg == "--min-n") o.min_n = std::stoull(value);
+            else if (arg == "--max-n") o.max_n = std::stoull(value);
+            else if (arg == "--work") o.work = std::stod(value);
+            else if (arg == "--json") o.json = value;
+            else if (arg == "--compare") o.compare = value;
+            else if (arg == "--threshold") o.threshold = std::stod(value);
+            else throw std::runtime_error("unknown option " + arg);
+        }
+        o.min_n = std::max<std::size_t>(o.min_n, 16);
+        return o;
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parse(argc, argv);
+
+        std::cout << "kernels: " << stencil_kernels().isa
+            << ", threads: " << std::thread::hardware_concurrency() << "\n";
+        std::cout << "case                        N     ns/cell    GB/s eff.  allocs/step\n";
+
+        std::vector<Result> results;
+        for (std::size_t n = options.min_n; n <= options.max_n; n *= 4) {
+            std::size_t steps = std::max<std::size_t>(4,
+                static_cast<std::size_t>(options.work / static_cast<double>(n)));
+
+            std::size_t first = results.size();
+            bench_schemes(n, steps, results);
+            bench_solvers(n, steps, results);
+            bench_analytical(n, std::max<std::size_t>(1, steps / 16), results);
+
+            for (std::size_t i = first; i < results.size(); ++i) {
+                const Result& r = results[i];
+                std::cout << std::left << std::setw(26) << r.name
+                    << std::right << std::setw(9) << r.n
+                    << std::fixed << std::setprecision(3)
+                    << std::setw(11) << r.ns_per_cell
+                    << std::setw(12) << r.gb_per_s
+                    << std::setw(13) << r.allocs_per_step << "\n";
+            }
+        }
+
+        if (!options.json.empty()) {
+            write_json(options.json, results);
+            std::cout << "Results written to: " << options.json << "\n";
+        }
+
+        if (!options.compare.empty()) {
+            auto baseline = read_baseline(options.compare);
+            int regressions = 0;
+            std::cout << "\ncomparison with " << options.compare
+                << " (threshold " << std::defaultfloat << 100.0 * options.threshold << "%)\n";
+            for (const Result& r : results) {
+                auto it = baseline.find({ r.name, r.n });
+                if (it == baseline.end() || it->second <= 0.0) {
+                    continue;
+                }
+                double change = r.ns_per_cell / it->second - 1.0;
+                bool regressed = change > options.threshold;
+                regressions += regressed ? 1 : 0;
+                std::cout << std::left << std::setw(26) << r.name
+                    << std::right << std::setw(9) << r.n
+                    << std::showpos << std::setw(10) << std::setprecision(1)
+                    << 100.0 * change << "%" << std::noshowpos
+                    << (regressed ? "   REGRESSION" : "") << "\n";
+            }
+            if (regressions > 0) {
+                std::cout << regressions << " regression(s)\n";
+                return 1;
+            }
+            std::cout << "no regressions\n";
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return 2;
+    }
+
+    return 0;
+}
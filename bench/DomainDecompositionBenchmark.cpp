@@ -0,0 +1,61 @@
+// Multi-process domain decomposition vs the single-process Simulation.
+// Usage: DomainDecompositionBenchmark [scheme] [dx] [t_end] [max_ranks]
+//
+// Wall time of DistributedSimulation for 1..max_ranks processes (fork and
+// gather included) and the max deviation from Simulation: 0 for the
+// explicit schemes, round-off for the implicit ones (distributed solve).
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DistributedSimulation.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+
+int main(int argc, char** argv) {
+    const std::string scheme = (argc > 1) ? argv[1] : "DuFortFrankel";
+    const double dx = (argc > 2) ? std::atof(argv[2]) : 0.005;
+    const double t_end = (argc > 3) ? std::atof(argv[3]) : 0.001;
+    const std::size_t max_ranks = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 8;
+    const double dt = 0.1 * dx * dx / 93.0;  // r = 0.1
+
+    Grid1D grid(31.0, dx);
+    HeatProblem problem(grid, 93.0, 38.0, 149.0);
+
+    Simulation reference(problem, make_scheme(scheme, problem), dt, t_end);
+    auto start = std::chrono::steady_clock::now();
+    reference.run_to_end();
+    auto stop = std::chrono::steady_clock::now();
+    const double serial = std::chrono::duration<double>(stop - start).count();
+
+    std::cout << scheme << ", nodes: " << grid.size()
+        << ", steps: " << std::round(t_end / dt) << "\n";
+    std::cout << "Simulation: " << std::fixed << std::setprecision(3) << serial * 1e3 << " ms\n";
+    std::cout << std::setw(6) << "ranks" << std::setw(12) << "ms" << std::setw(10) << "speedup"
+        << std::setw(13) << "max diff" << "\n";
+
+    for (std::size_t P = 1; P <= max_ranks; ++P) {
+        DistributedSimulation sim(problem, scheme, dt, t_end, P);
+        start = std::chrono::steady_clock::now();
+        sim.run_to_end();
+        stop = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(stop - start).count();
+
+        double diff = 0.0;
+        for (std::size_t i = 0; i < grid.size(); ++i) {
+            diff = std::max(diff, std::abs(sim.solution()[i] - reference.solution()[i]));
+        }
+        std::cout << std::setw(6) << P
+            << std::fixed << std::setprecision(3) << std::setw(12) << seconds * 1e3
+            << std::setprecision(2) << std::setw(10) << serial / seconds
+            << std::scientific << std::setw(13) << diff << "\n";
+    }
+    return 0;
+}
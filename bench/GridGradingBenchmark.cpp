@@ -0,0 +1,64 @@
+// Accuracy of uniform vs wall-graded grids at equal node counts.
+// Usage: GridGradingBenchmark [scheme] [t_end] [dt]
+//
+// Max deviation from the analytical solution at t_end for N = 2^k + 1
+// nodes (so that the uniform spacing divides L) on the uniform grid and on
+// Grid1D::graded() grids with increasing stretching.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+
+namespace {
+    double max_error(const Grid1D& grid, const std::string& scheme,
+        double dt, double t_end)
+    {
+        HeatProblem problem(grid, 93.0, 38.0, 149.0);
+        Simulation sim(problem, make_scheme(scheme, problem), dt, t_end);
+        double t = sim.run_to_end();
+
+        std::vector<double> T_exact;
+        AnalyticalSolution(problem).evaluate(grid, t, T_exact);
+
+        double m = 0.0;
+        for (std::size_t i = 0; i < T_exact.size(); ++i) {
+            m = std::max(m, std::abs(sim.solution()[i] - T_exact[i]));
+        }
+        return m;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::string scheme = (argc > 1) ? argv[1] : "Laasonen";
+    const double t_end = (argc > 2) ? std::atof(argv[2]) : 0.5;
+    const double dt = (argc > 3) ? std::atof(argv[3]) : 1e-4;
+    const double L = 31.0;
+    const double stretchings[] = { 0.5, 1.0, 1.5, 2.0 };
+
+    std::cout << scheme << ", t_end = " << t_end << ", dt = " << dt << "\n";
+    std::cout << std::setw(6) << "nodes" << std::setw(12) << "uniform";
+    for (double s : stretchings) {
+        std::cout << std::setw(9) << "s = " << std::fixed << std::setprecision(1) << s;
+    }
+    std::cout << "\n" << std::scientific << std::setprecision(3);
+
+    for (std::size_t cells = 16; cells <= 1024; cells *= 2) {
+        const std::size_t N = cells + 1;
+        std::cout << std::setw(6) << N
+            << std::setw(12) << max_error(Grid1D(L, L / static_cast<double>(cells)), scheme, dt, t_end);
+        for (double s : stretchings) {
+            std::cout << std::setw(12) << max_error(Grid1D::graded(L, N, s), scheme, dt, t_end);
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
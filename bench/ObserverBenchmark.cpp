@@ -0,0 +1,110 @@
+// Cost of in-situ observation and gain of the steady-state early exit.
+// Usage: ObserverBenchmark [scheme] [dx] [t_end] [dt]
+//
+// Times one run plain, with a DiagnosticsRecorder every step (fused
+// statistics), with an observer that sweeps the profile itself every step
+// (what the fusion avoids), and with a ConvergenceMonitor that ends the
+// run at steady state. Finally checks that the monitor lets Richardson and
+// FTCS on the reference problem of main.cpp run past their quiet start-up
+// step; both diverge there, so they must run to the end (exit code 1 if
+// not).
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ConvergenceMonitor.h"
+#include "DiagnosticsRecorder.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+
+namespace {
+    // Heat content by its own pass over the profile
+    class SweepingObserver : public Observer {
+    public:
+        void observe(const Observation& observation) override {
+            double sum = 0.0;
+            for (double v : observation.T) {
+                sum += v;
+            }
+            total_ += sum;
+        }
+        double total_ = 0.0;
+    };
+
+    double seconds(const std::function<void()>& run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(stop - start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::string scheme = (argc > 1) ? argv[1] : "DuFortFrankel";
+    const double dx = (argc > 2) ? std::atof(argv[2]) : 0.05;
+    const double t_end = (argc > 3) ? std::atof(argv[3]) : 0.5;
+    const double dt = (argc > 4) ? std::atof(argv[4]) : 0.4 * dx * dx / 93.0;
+
+    Grid1D grid(31.0, dx);
+    HeatProblem problem(grid, 93.0, 38.0, 149.0);
+    const double cell_steps = static_cast<double>(grid.size()) * std::round(t_end / dt);
+
+    std::cout << scheme << ", nodes: " << grid.size()
+        << ", steps: " << std::round(t_end / dt) << "\n";
+    auto report = [&](const std::string& name, double s) {
+        std::cout << std::left << std::setw(22) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10) << s * 1e3 << " ms"
+            << std::setw(10) << s * 1e9 / cell_steps << " ns/cell-step\n";
+    };
+
+    Simulation plain(problem, make_scheme(scheme, problem), dt, t_end);
+    report("plain", seconds([&] { plain.run_to_end(); }));
+
+    Simulation fused(problem, make_scheme(scheme, problem), dt, t_end);
+    DiagnosticsRecorder recorder;
+    fused.add_observer(recorder);
+    report("recorder (fused)", seconds([&] { fused.run_to_end(); }));
+
+    Simulation swept(problem, make_scheme(scheme, problem), dt, t_end);
+    SweepingObserver sweeping;
+    swept.add_observer(sweeping);
+    report("extra sweep", seconds([&] { swept.run_to_end(); }));
+
+    std::cout << "identical to plain: "
+        << (fused.solution() == plain.solution() ? "yes" : "NO") << "\n";
+
+    // Steady state: run to 100 hr, stop once the change per step is below
+    // 1e-7 per hr of dt
+    Simulation long_run(problem, make_scheme(scheme, problem), dt, 100.0);
+    ConvergenceMonitor monitor(1e-7 * dt);
+    long_run.add_observer(monitor);
+    double t = 0.0;
+    const double s = seconds([&] { t = long_run.run_to_end(); });
+    std::cout << "early exit: t = " << std::setprecision(4) << t << " of 100 hr ("
+        << monitor.step() << " steps) in " << std::setprecision(3) << s * 1e3 << " ms\n";
+
+    // dx = 0.05, dt = 0.01, t_end = 0.5: the first step changes nothing in
+    // the interior, the later ones blow up
+    Grid1D reference_grid(31.0, 0.05);
+    HeatProblem reference(reference_grid, 93.0, 38.0, 149.0);
+    bool ok = true;
+    for (const std::string name : { "Richardson", "FTCS" }) {
+        Simulation sim(reference, make_scheme(name, reference), 0.01, 0.5);
+        ConvergenceMonitor check(1e-7 * 0.01);
+        sim.add_observer(check);
+        sim.run_to_end();
+        std::cout << "reference " << name << ": "
+            << (check.converged() ? "stopped at step " + std::to_string(check.step()) + " (WRONG)"
+                                  : std::string("ran to the end")) << "\n";
+        ok = ok && !check.converged();
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// Speed and accuracy of the implicit schemes in float, double, long double and mixed
+// precision (double state, float factorization + iterative refinement).
+// Usage: PrecisionBenchmark [dx] [repeats] [dt]
+//
+// "err exact" is the max deviation from the analytical solution (truncation
+// plus rounding); "err ref" the max deviation from the long double run of
+// the same scheme, i.e. the rounding error alone.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AnalyticalSolution.h"
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "PrecisionSimulation.h"
+
+namespace {
+    struct Run {
+        double seconds = 0.0;
+        double t = 0.0;
+        std::size_t sweeps = 0;
+        std::vector<double> T;
+    };
+
+    template <class Real, class SolveReal = Real>
+    Run measure(const HeatProblem& problem, const std::string& scheme,
+        double dt, double t_end, int repeats)
+    {
+        PrecisionSimulation<Real, SolveReal> sim(problem, scheme, dt, t_end);
+        Run run;
+        run.t = sim.run_to_end();  // warm-up
+
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k < repeats; ++k) {
+            sim.run_to_end();
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        run.seconds = std::chrono::duration<double>(stop - start).count() / repeats;
+        run.sweeps = sim.refinement_sweeps();
+        sim.solution(run.T);
+        return run;
+    }
+
+    double max_diff(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        double m = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            m = std::max(m, std::abs(a[i] - b[i]));
+        }
+        return m;
+    }
+}
+
+int main(int argc, char** argv) {
+    const double dx = (argc > 1) ? std::atof(argv[1]) : 0.005;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 20;
+    const double dt = (argc > 3) ? std::atof(argv[3]) : 0.01;
+
+    // Reference problem of main.cpp on a finer grid
+    Grid1D grid(31.0, dx);
+    HeatProblem problem(grid, 93.0, 38.0, 149.0);
+    const double t_end = 0.5;
+    const std::size_t N = grid.size();
+    const double n_steps = std::round(t_end / dt);
+
+    std::cout << "nodes: " << N << ", steps: " << n_steps
+        << ", repeats: " << repeats << "\n";
+    std::cout << std::left << std::setw(15) << "scheme" << std::setw(13) << "precision"
+        << std::right << std::setw(10) << "ms/run" << std::setw(14) << "ns/cell-step"
+        << std::setw(13) << "err exact" << std::setw(13) << "err ref"
+        << std::setw(13) << "sweeps/step" << "\n";
+
+    // The defaults give r = D dt / dx^2 = 37,200. Richardson is unstable at
+    // any r, and DuFort-Frankel's FTCS start-up step needs r <= 1/2 to stay
+    // bounded (here about 4.6 million steps), so both are left out: their
+    // rows would compare rounding on a blown-up solution.
+    for (const std::string scheme : { "Laasonen", "CrankNicolson" }) {
+        Run reference = measure<long double>(problem, scheme, dt, t_end, 1);
+        std::vector<double> T_exact;
+        AnalyticalSolution(problem).evaluate(grid, reference.t, T_exact);
+
+        std::vector<std::pair<std::string, Run>> runs;
+        runs.emplace_back("float", measure<float>(problem, scheme, dt, t_end, repeats));
+        runs.emplace_back("double", measure<double>(problem, scheme, dt, t_end, repeats));
+        runs.emplace_back("long double", measure<long double>(problem, scheme, dt, t_end, repeats));
+        runs.emplace_back("mixed", measure<double, float>(problem, scheme, dt, t_end, repeats));
+
+        for (const auto& [precision, run] : runs) {
+            std::cout << std::left << std::setw(15) << scheme << std::setw(13) << precision
+                << std::right << std::fixed << std::setprecision(3)
+                << std::setw(10) << run.seconds * 1e3
+                << std::setw(14) << run.seconds * 1e9 / (static_cast<double>(N) * n_steps)
+                << std::scientific << std::setprecision(2)
+                << std::setw(13) << max_diff(run.T, T_exact)
+                << std::setw(13) << max_diff(run.T, reference.T)
+                << std::fixed << std::setprecision(2)
+                << std::setw(13) << run.sweeps / n_steps << "\n";
+        }
+    }
+    return 0;
+}
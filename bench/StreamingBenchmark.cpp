@@ -0,0 +1,65 @@
+// Out-of-core marching through memory-mapped time levels.
+// Usage: StreamingBenchmark [level_files] [million_nodes] [steps] [chunk_nodes] [steps_per_chunk]
+//
+// DuFort-Frankel at r = 0.4 with the levels in level_files_{0,1}.bin:
+// time per cell-step and the file traffic (32 bytes per node and pass)
+// per second. Up to 20 million nodes the result is also checked against
+// the in-memory Simulation.
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "SchemeFactory.h"
+#include "Simulation.h"
+#include "StreamingSimulation.h"
+
+int main(int argc, char** argv) {
+    const std::string files = (argc > 1) ? argv[1] : "heat_levels";
+    const double million_nodes = (argc > 2) ? std::atof(argv[2]) : 10.0;
+    const std::size_t steps = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 256;
+    TemporalBlocking chunking{ std::size_t(1) << 20, 64 };
+    if (argc > 4) chunking.tile_size = std::strtoul(argv[4], nullptr, 10);
+    if (argc > 5) chunking.steps_per_tile = std::strtoul(argv[5], nullptr, 10);
+
+    const double L = 31.0;
+    const double D = 93.0;
+    Grid1D grid(L, L / (million_nodes * 1e6));
+    HeatProblem problem(grid, D, 38.0, 149.0);
+    const double dt = 0.4 * grid.dx() * grid.dx() / D;
+    const double t_end = static_cast<double>(steps) * dt;
+    const std::size_t N = grid.size();
+
+    StreamingSimulation sim(problem, "DuFortFrankel", dt, t_end, files, chunking);
+    auto start = std::chrono::steady_clock::now();
+    sim.run_to_end();
+    auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+
+    const double passes = 1.0 + std::ceil((steps - 1.0) / static_cast<double>(chunking.steps_per_tile));
+    const double bytes = 32.0 * static_cast<double>(N) * passes;
+    std::cout << "nodes: " << N << " (" << std::fixed << std::setprecision(2)
+        << 16.0 * static_cast<double>(N) / 1e9 << " GB of levels), steps: " << steps
+        << ", chunk: " << chunking.tile_size << " nodes x " << chunking.steps_per_tile << " steps\n";
+    std::cout << "time: " << std::setprecision(3) << seconds << " s, "
+        << seconds * 1e9 / (static_cast<double>(N) * steps) << " ns/cell-step, "
+        << bytes / seconds / 1e9 << " GB/s file traffic (" << passes << " passes)\n";
+
+    if (N <= 20000000) {
+        Simulation reference(problem, make_scheme("DuFortFrankel", problem), dt, t_end);
+        start = std::chrono::steady_clock::now();
+        reference.run_to_end();
+        stop = std::chrono::steady_clock::now();
+        bool identical = true;
+        for (std::size_t i = 0; i < N; ++i) {
+            identical = identical && sim.solution()[i] == reference.solution()[i];
+        }
+        std::cout << "in memory: " << std::chrono::duration<double>(stop - start).count()
+            << " s, identical: " << (identical ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Step-by-step vs temporally blocked marching of the explicit schemes.
+// Usage: TemporalBlockingBenchmark [n_nodes] [n_steps] [tile_size] [steps_per_tile]
+//
+// Effective bandwidth counts the traffic of a plain step (read levels n and
+// n-1, write n+1: 24 bytes per node) whichever way the steps were computed.
+// The blocked pass calls step_blocked() directly, so it is timed even for
+// grids that Simulation marches plainly (TemporalBlocking::pays_off).
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Grid1D.h"
+#include "HeatProblem.h"
+#include "TimeLevels.h"
+#include "RichardsonScheme.h"
+#include "DuFortFrankelScheme.h"
+
+namespace {
+    template <class Scheme>
+    void run(const std::string& name, const HeatProblem& problem,
+        std::size_t n_steps, const TemporalBlocking& blocking)
+    {
+        const std::size_t N = problem.grid().size();
+        const double dt = 1e-4;
+
+        TimeLevels plain(N), blocked(N);
+        Scheme plain_scheme(problem), blocked_scheme(problem);
+
+        for (TimeLevels* levels : { &plain, &blocked }) {
+            problem.set_initial_condition(levels->curr());
+            levels->prev() = levels->curr();
+        }
+
+        // Start-up step (not blocked)
+        plain_scheme.step(plain.curr(), plain.prev(), plain.next(), 0.0, dt);
+        plain.rotate();
+        blocked_scheme.step(blocked.curr(), blocked.prev(), blocked.next(), 0.0, dt);
+        blocked.rotate();
+
+        auto start = std::chrono::steady_clock::now();
+        double t = dt;
+        for (std::size_t n = 1; n < n_steps; ++n) {
+            plain_scheme.step(plain.curr(), plain.prev(), plain.next(), t, dt);
+            plain.rotate();
+            t += dt;
+        }
+        auto middle = std::chrono::steady_clock::now();
+        blocked_scheme.step_blocked(blocked.curr(), blocked.prev(), dt, dt,
+            n_steps - 1, blocking);
+        auto stop = std::chrono::steady_clock::now();
+
+        bool identical = std::memcmp(plain.curr().data(), blocked.curr().data(),
+            N * sizeof(double)) == 0;
+
+        const double cell_steps = static_cast<double>(N) * static_cast<double>(n_steps - 1);
+        for (int pass = 0; pass < 2; ++pass) {
+            double seconds = std::chrono::duration<double>(
+                pass == 0 ? middle - start : stop - middle).count();
+            std::cout << std::left << std::setw(15) << name
+                << std::setw(9) << (pass == 0 ? "plain" : "blocked")
+                << std::right << std::fixed << std::setprecision(3)
+                << std::setw(10) << 1e9 * seconds / cell_steps
+                << std::setw(10) << 24.0 * cell_steps / seconds / 1e9
+                << (pass == 1 ? (identical ? "   identical" : "   MISMATCH") : "")
+                << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t n_nodes = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 22);
+    std::size_t n_steps = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 65;
+    TemporalBlocking blocking;
+    if (argc > 3) blocking.tile_size = std::strtoull(argv[3], nullptr, 10);
+    if (argc > 4) blocking.steps_per_tile = std::strtoull(argv[4], nullptr, 10);
+
+    // Unit-length wall; D chosen so that r = 0.1 for dt = 1e-4
+    const double dx = 1.0 / static_cast<double>(n_nodes - 1);
+    Grid1D grid(1.0, dx);
+    HeatProblem problem(grid, 0.1 * dx * dx / 1e-4, 38.0, 149.0);
+
+    std::cout << "nodes: " << grid.size() << ", steps: " << n_steps
+        << ", tile: " << blocking.tile_size
+        << ", steps/tile: " << blocking.steps_per_tile
+        << ", Simulation blocks it: " << (blocking.pays_off(grid.size()) ? "yes" : "no") << "\n";
+    std::cout << "scheme         mode     ns/cell   GB/s eff.\n";
+
+    run<RichardsonScheme>("Richardson", problem, n_steps, blocking);
+    run<DuFortFrankelScheme>("DuFortFrankel", problem, n_steps, blocking);
+
+    return 0;
+}
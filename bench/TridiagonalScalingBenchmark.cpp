@@ -0,0 +1,71 @@
+// Strong-scaling benchmark of the partitioned tri-diagonal solve.
+// Usage: TridiagonalScalingBenchmark [n_rows] [repeats] [max_threads]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "TridiagonalFactorization.h"
+
+int main(int argc, char** argv) {
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 22);
+    int repeats = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+    // Laasonen matrix for r = 0.5
+    const double r = 0.5;
+    const double a = -r, b = 1.0 + 2.0 * r, c = -r;
+
+    std::vector<double> rhs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        rhs[i] = 38.0 + 111.0 * std::sin(0.001 * static_cast<double>(i));
+    }
+
+    TridiagonalFactorization serial;
+    serial.factor(a, b, c, n);
+    std::vector<double> reference = rhs;
+    serial.solve(reference.data());
+
+    std::size_t max_threads = (argc > 3) ? std::strtoull(argv[3], nullptr, 10)
+        : ThreadPool::shared().size();
+    std::vector<double> d(n);
+    double t_serial = 0.0;
+
+    std::cout << "rows: " << n << ", repeats: " << repeats << "\n";
+    std::cout << "threads  ms/solve  speedup  efficiency  max|diff|\n";
+
+    for (std::size_t threads = 1; threads <= max_threads; ++threads) {
+        TridiagonalFactorization factorization;
+        factorization.factor(a, b, c, n, threads);
+
+        double best = 1e300;
+        for (int rep = 0; rep < repeats; ++rep) {
+            std::copy(rhs.begin(), rhs.end(), d.begin());
+            auto start = std::chrono::steady_clock::now();
+            factorization.solve(d.data());
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        if (threads == 1) {
+            t_serial = best;
+        }
+
+        double max_diff = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            max_diff = std::max(max_diff, std::fabs(d[i] - reference[i]));
+        }
+
+        double speedup = t_serial / best;
+        std::cout << std::setw(7) << threads
+            << std::fixed << std::setprecision(3) << std::setw(10) << best
+            << std::setprecision(2) << std::setw(9) << speedup
+            << std::setw(12) << speedup / static_cast<double>(threads)
+            << std::scientific << std::setprecision(2) << std::setw(11) << max_diff
+            << std::defaultfloat << "\n";
+    }
+
+    return 0;
+}
@@ -1,21 +1,109 @@
-﻿#include <iostream>
+﻿#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "Grid1D.h"
 #include "HeatProblem.h"
+#include "AdaptiveSimulation.h"
+#include "AnalyticalSolution.h"
+#include "ComparisonRunner.h"
+#include "OutputManager.h"
+#include "ConvergenceStudy.h"
+#include "ParameterSweep.h"
+#include "SchemeFactory.h"
 #include "Simulation.h"
+#include "Telemetry.h"
+
+namespace {
+    double max_error(const HeatProblem& problem, const std::vector<double>& T, double t)
+    {
+        std::vector<double> T_exact;
+        AnalyticalSolution(problem).evaluate(problem.grid(), t, T_exact);
+        double m = 0.0;
+        for (std::size_t i = 0; i < T.size(); ++i) {
+            m = std::max(m, std::abs(T[i] - T_exact[i]));
+        }
+        return m;
+    }
 
-#include "RichardsonScheme.h"
-#include "DuFortFrankelScheme.h"
-#include "LaasonenScheme.h"
-#include "CrankNicolsonScheme.h"
+    // heat --adaptive: step-doubled run of an implicit scheme on the
+    // reference wall against fixed-dt runs, with the cost in implicit
+    // solves and the accuracy reached
+    void compare_adaptive(const HeatProblem& problem, const std::string& scheme,
+        double dt, double t_end)
+    {
+        AdaptiveSimulation adaptive(problem, scheme, dt, t_end);
+        double t = adaptive.run_to_end();
+        const AdaptiveStats& stats = adaptive.stats();
 
-#include "OutputManager.h"
+        auto row = [](const std::string& mode, std::size_t steps, std::size_t solves,
+            double error) {
+            std::cout << std::left << std::setw(22) << mode << std::right
+                << std::setw(9) << steps << std::setw(9) << solves
+                << std::scientific << std::setprecision(3) << std::setw(14) << error << "\n";
+        };
+        auto fixed = [&](double fixed_dt) {
+            Simulation sim(problem, make_scheme(scheme, problem), fixed_dt, t_end);
+            double t_fixed = sim.run_to_end();
+            std::size_t steps = static_cast<std::size_t>(std::round(t_end / fixed_dt));
+            std::ostringstream mode;
+            mode << "fixed dt = " << std::setprecision(3) << fixed_dt;
+            row(mode.str(), steps, steps,
+                max_error(problem, sim.solution(), t_fixed));
+        };
 
-int main() {
+        std::cout << scheme << ", t_end = " << t_end << " hr\n"
+            << std::left << std::setw(22) << "mode" << std::right << std::setw(9) << "steps"
+            << std::setw(9) << "solves" << std::setw(14) << "max error (K)" << "\n";
+        fixed(dt);
+        row("adaptive", stats.accepted, stats.solves(), max_error(problem, adaptive.solution(), t));
+        // A fixed run of the same cost
+        fixed(t_end / static_cast<double>(stats.solves()));
+        std::cout << "rejected steps: " << stats.rejected
+            << ", solves saved: " << stats.solves_saved() << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
     try {
         std::cout << "=== 1D Heat Equation Solver ===\n";
 
+        // heat --convergence [levels]: grid-convergence study
+        if (argc > 1 && std::string(argv[1]) == "--convergence") {
+            ConvergenceOptions options;
+            if (argc > 2) {
+                options.levels = std::stoul(argv[2]);
+            }
+            ConvergenceStudy study(options);
+            std::vector<ConvergenceLevel> results = study.run();
+            ConvergenceStudy::print_table(results, std::cout);
+            ConvergenceStudy::write_csv(results, "convergence_study.csv");
+            return 0;
+        }
+
+        // heat --adaptive [scheme] [t_end]: adaptive vs fixed time steps
+        if (argc > 1 && std::string(argv[1]) == "--adaptive") {
+            Grid1D grid(31.0, 0.05);
+            HeatProblem problem(grid, 93.0, 38.0, 149.0);
+            compare_adaptive(problem, argc > 2 ? argv[2] : "CrankNicolson", 0.01,
+                argc > 3 ? std::stod(argv[3]) : 0.5);
+            return 0;
+        }
+
+        // heat <spec file>: parameter sweep instead of the reference run
+        if (argc > 1) {
+            ParameterSweep sweep;
+            sweep.load(argv[1]);
+            std::cout << "Sweeping " << sweep.cases().size() << " cases...\n";
+            ParameterSweep::write_csv(sweep.run(), "sweep_results.csv");
+            return 0;
+        }
+
         double L = 31.0;   // cm
         double dx = 0.05;   // cm
         double D = 93.0;   // cm^2/hr
@@ -28,37 +116,26 @@ int main() {
         double dt = 0.01;  // hr  
         double t_end = 0.5;   // hr
 
-        // OutputManager (base_folder is not used anymore)
+        // OutputManager writes the CSV into this folder
         OutputManager out(".");
 
-        // Run each scheme, store final-time results
-        {
-            auto scheme = std::make_unique<RichardsonScheme>(problem);
-            Simulation sim(problem, std::move(scheme), dt, t_end);
-            sim.run("Richardson", out);
-        }
-
-        {
-            auto scheme = std::make_unique<DuFortFrankelScheme>(problem);
-            Simulation sim(problem, std::move(scheme), dt, t_end);
-            sim.run("DuFortFrankel", out);
-        }
+        // Run all schemes concurrently, store final-time results
+        ComparisonRunner runner(problem, dt, t_end);
+        runner.add_scheme("Richardson");
+        runner.add_scheme("DuFortFrankel");
+        runner.add_scheme("Laasonen");
+        runner.add_scheme("CrankNicolson");
+        runner.run(out);
 
-        {
-            auto scheme = std::make_unique<LaasonenScheme>(problem);
-            Simulation sim(problem, std::move(scheme), dt, t_end);
-            sim.run("Laasonen", out);
-        }
-
-        {
-            auto scheme = std::make_unique<CrankNicolsonScheme>(problem);
-            Simulation sim(problem, std::move(scheme), dt, t_end);
-            sim.run("CrankNicolson", out);
-        }
-      
         // Now write one combined CSV with all schemes + analytical solution
         out.write_combined_csv();
 
+        // Per-phase report (only in builds with HEAT_ENABLE_TELEMETRY)
+        if (Telemetry::enabled()) {
+            Telemetry::report_table(std::cout);
+            Telemetry::write_json("telemetry.json");
+        }
+
         std::cout << "Done. Check 1D_Heat_Equation_Solution.csv next to the EXE.\n";
     }
     catch (const std::exception& e) {